@@ -0,0 +1,66 @@
+/*
+ * Parses flag and arg lists with up to ten million values.
+ *
+ * The parser is placed into a small fixed buffer with parser_init_static(..), which can't grow. Parsing succeeds for
+ * any list length, thus lists are stored without any allocation and point directly into argv.
+ */
+#include "argparse.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+int main(int argc, char **argv) {
+    int sizes[] = {255, 256, 100000, 10000000};
+    static _Alignas(max_align_t) char storage[4096];
+
+    fprintf(stdout, "%10s %12s %12s %16s\n", "values", "flag list", "arg list", "parse ns/value");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        int n = sizes[s];
+        int count = 2 * n + 3;
+        char const **args = malloc(sizeof(char *) * count);
+        int pos = 0;
+        args[pos++] = "bench";
+        args[pos++] = "--shards";
+        for (int i = 0; i < n; ++i) {
+            args[pos++] = "shard";
+        }
+        args[pos++] = "--";
+        for (int i = 0; i < n; ++i) {
+            args[pos++] = "path";
+        }
+
+        parser_new_static(parser, storage, "bench", "Large list benchmark.");
+        add_flag_list(parser, shards, 's', "shards", "ID", "Shard IDs.", SET_NONE);
+        add_arg_list(parser, paths, "PATHS", "Input paths.");
+        if (parser_compile(parser) != 0) {
+            fprintf(stderr, "compile failed\n");
+            return 1;
+        }
+
+        double start = now_ns();
+        if (parser_parse_args(parser, args, count) != 0 || parser_error(parser) != ERR_NONE) {
+            fprintf(stderr, "parse failed\n");
+            return 1;
+        }
+        double parse = now_ns() - start;
+
+        if (flag_list_count(shards) != (size_t)n || arg_list_count(paths) != (size_t)n ||
+            flag_list_get(shards) != &args[2] || arg_list_get(paths) != &args[n + 3]) {
+            fprintf(stderr, "lists don't point into argv\n");
+            return 1;
+        }
+        fprintf(stdout, "%10d %12zu %12zu %16.1f\n", n, flag_list_count(shards), arg_list_count(paths),
+                parse / (2 * n));
+
+        parser_deinit(parser);
+        free(args);
+    }
+    return 0;
+}
@@ -0,0 +1,200 @@
+/*
+ * Compares flag lookup in the former packed linked-list layout with contiguous layouts.
+ *
+ * Each round registers N long flags and looks up every flag once in shuffled order:
+ *
+ *   packed    linear scan over the former packed items, allocated one by one
+ *   soa       linear scan over contiguous arrays of long names and lengths, the layout of the compiled tables
+ *   compiled  parser_parse_args(..) over the compiled tables, thus the hash index of long flags
+ *
+ * packed and soa differ only in layout, compiled additionally shows the effect of the hash index. Pass a single
+ * layout, e.g. `layout soa`, and run the binary through `perf stat -e cache-misses,cache-references` to read the
+ * cache behaviour of that layout alone. Without argument, all layouts are timed.
+ */
+#include "argparse.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/*!
+ * Replica of the previous packed flag item, allocated one by one
+ */
+struct __attribute__((packed)) packed_item {
+    char _short;
+    unsigned int _count : 8;
+    unsigned int _flags : 8;
+    char const *_long;
+    char const *_placeholder;
+    char const *_desc;
+    char const *const *_values;
+    int (*takes)();
+    int (*parse)(struct packed_item *, char const *const *, int);
+    struct packed_item *_next;
+};
+
+static int packed_takes() { return 0; }
+
+static int packed_parse(struct packed_item *ctx, char const *const *argv, int argc) {
+    ctx->_count += 1;
+    return 0;
+}
+
+static double bench_packed(char **names, char const **argv, int n) {
+    struct packed_item *head = NULL;
+    struct packed_item *tail = NULL;
+    void **noise = malloc(sizeof(void *) * n);
+    for (int i = 0; i < n; ++i) {
+        struct packed_item *item = malloc(sizeof(struct packed_item));
+        // Interleave unrelated allocations like a real application registering its schema
+        noise[i] = malloc(64 + (i % 7) * 16);
+        memset(item, 0, sizeof(struct packed_item));
+        item->_long = names[i];
+        item->_desc = "Description";
+        item->takes = packed_takes;
+        item->parse = packed_parse;
+        if (tail == NULL) {
+            head = item;
+        } else {
+            tail->_next = item;
+        }
+        tail = item;
+    }
+
+    double start = now_ns();
+    for (int a = 1; a <= n; ++a) {
+        char const *arg = &argv[a][2];
+        int len = strlen(arg);
+        struct packed_item *it = head;
+        while (it != NULL) {
+            int it_len = strlen(it->_long);
+            if (len == it_len && strcmp(it->_long, arg) == 0) {
+                break;
+            }
+            it = it->_next;
+        }
+        if (it == NULL || it->parse(it, NULL, 0) != 0) {
+            fprintf(stderr, "packed lookup failed\n");
+            exit(1);
+        }
+    }
+    double elapsed = now_ns() - start;
+
+    while (head != NULL) {
+        struct packed_item *next = head->_next;
+        free(head);
+        head = next;
+    }
+    for (int i = 0; i < n; ++i) {
+        free(noise[i]);
+    }
+    free(noise);
+    return elapsed;
+}
+
+static double bench_soa(char **names, char const **argv, int n) {
+    char const **longs = malloc(sizeof(char const *) * n);
+    size_t *lens = malloc(sizeof(size_t) * n);
+    size_t *counts = calloc(n, sizeof(size_t));
+    for (int i = 0; i < n; ++i) {
+        longs[i] = names[i];
+        lens[i] = strlen(names[i]);
+    }
+
+    double start = now_ns();
+    for (int a = 1; a <= n; ++a) {
+        char const *arg = &argv[a][2];
+        size_t len = strlen(arg);
+        int i = 0;
+        while (i < n && (lens[i] != len || memcmp(longs[i], arg, len) != 0)) {
+            ++i;
+        }
+        if (i == n) {
+            fprintf(stderr, "soa lookup failed\n");
+            exit(1);
+        }
+        counts[i] += 1;
+    }
+    double elapsed = now_ns() - start;
+
+    free(longs);
+    free(lens);
+    free(counts);
+    return elapsed;
+}
+
+static double bench_compiled(char **names, char const **argv, int n) {
+    parser_new(parser, "bench", "Layout benchmark.");
+    for (int i = 0; i < n; ++i) {
+        parser_add_flag(parser, '\0', names[i], "Description");
+    }
+    if (parser_compile(parser) != 0) {
+        fprintf(stderr, "compile failed\n");
+        exit(1);
+    }
+
+    double start = now_ns();
+    if (parser_parse_args(parser, argv, n + 1) != 0) {
+        fprintf(stderr, "compiled parse failed\n");
+        exit(1);
+    }
+    double elapsed = now_ns() - start;
+
+    parser_deinit(parser);
+    return elapsed;
+}
+
+int main(int argc, char **argv) {
+    int sizes[] = {16, 128, 1024, 8192};
+    char const *layout = argc > 1 ? argv[1] : NULL;
+    if (layout != NULL && strcmp(layout, "packed") != 0 && strcmp(layout, "soa") != 0 &&
+        strcmp(layout, "compiled") != 0) {
+        fprintf(stderr, "Usage: %s [packed|soa|compiled]\n", argv[0]);
+        return 1;
+    }
+    srand(42);
+
+    fprintf(stdout, "%8s %16s %16s %16s\n", "flags", "packed ns/flag", "soa ns/flag", "compiled ns/flag");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        int n = sizes[s];
+        char **names = malloc(sizeof(char *) * n);
+        char const **args = malloc(sizeof(char *) * (n + 1));
+        for (int i = 0; i < n; ++i) {
+            names[i] = malloc(32);
+            snprintf(names[i], 32, "option-%d", i);
+        }
+        args[0] = "bench";
+        for (int i = 0; i < n; ++i) {
+            char *arg = malloc(40);
+            snprintf(arg, 40, "--%s", names[i]);
+            args[i + 1] = arg;
+        }
+        for (int i = n; i > 1; --i) {
+            int j = 1 + rand() % i;
+            char const *tmp = args[i];
+            args[i] = args[j];
+            args[j] = tmp;
+        }
+
+        // Layouts not selected are skipped and reported as 0
+        double packed = layout == NULL || strcmp(layout, "packed") == 0 ? bench_packed(names, args, n) : 0;
+        double soa = layout == NULL || strcmp(layout, "soa") == 0 ? bench_soa(names, args, n) : 0;
+        double compiled = layout == NULL || strcmp(layout, "compiled") == 0 ? bench_compiled(names, args, n) : 0;
+        fprintf(stdout, "%8d %16.1f %16.1f %16.1f\n", n, packed / n, soa / n, compiled / n);
+
+        for (int i = 0; i < n; ++i) {
+            free(names[i]);
+            free((char *)args[i + 1]);
+        }
+        free(names);
+        free(args);
+    }
+    return 0;
+}
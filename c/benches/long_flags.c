@@ -0,0 +1,73 @@
+/*
+ * Measures the cost of resolving `--long` flags while the number of registered flags scales from 10 to 10,000.
+ *
+ * Each round registers N long flags and parses a commandline providing every flag once in shuffled order. With the
+ * hashed long name index the cost per flag stays constant independent of N.
+ */
+#include "argparse.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+int main(int argc, char **argv) {
+    int sizes[] = {10, 100, 1000, 10000};
+    srand(42);
+
+    fprintf(stdout, "%8s %16s %16s\n", "flags", "setup ns/flag", "parse ns/flag");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        int n = sizes[s];
+        char **names = malloc(sizeof(char *) * n);
+        char const **args = malloc(sizeof(char *) * (n + 1));
+        for (int i = 0; i < n; ++i) {
+            names[i] = malloc(32);
+            snprintf(names[i], 32, "long-option-%d", i);
+        }
+        args[0] = "bench";
+        for (int i = 0; i < n; ++i) {
+            char *arg = malloc(40);
+            snprintf(arg, 40, "--%s", names[i]);
+            args[i + 1] = arg;
+        }
+        for (int i = n; i > 1; --i) {
+            int j = 1 + rand() % i;
+            char const *tmp = args[i];
+            args[i] = args[j];
+            args[j] = tmp;
+        }
+
+        double start = now_ns();
+        parser_new(parser, "bench", "Long flag benchmark.");
+        for (int i = 0; i < n; ++i) {
+            parser_add_flag(parser, '\0', names[i], "Description");
+        }
+        if (parser_compile(parser) != 0) {
+            fprintf(stderr, "compile failed\n");
+            return 1;
+        }
+        double setup = now_ns() - start;
+
+        start = now_ns();
+        if (parser_parse_args(parser, args, n + 1) != 0) {
+            fprintf(stderr, "parse failed\n");
+            return 1;
+        }
+        double parse = now_ns() - start;
+        fprintf(stdout, "%8d %16.1f %16.1f\n", n, setup / n, parse / n);
+
+        parser_deinit(parser);
+        for (int i = 0; i < n; ++i) {
+            free(names[i]);
+            free((char *)args[i + 1]);
+        }
+        free(names);
+        free(args);
+    }
+    return 0;
+}
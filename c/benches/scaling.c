@@ -0,0 +1,75 @@
+/*
+ * Verifies that parsing scales linearly with the number of commandline arguments.
+ *
+ * Each round parses `-o out -l <N list values> -- <N positional values>` for growing N. The time per argument stays
+ * constant if every argument is classified once. The benchmark fails if the time per argument of the largest
+ * commandline exceeds MAX_RATIO times that of the smallest, which a quadratic pass would exceed by far.
+ */
+#include "argparse.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define MAX_RATIO 3.0
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+int main(void) {
+    int sizes[] = {1000, 10000, 100000, 1000000};
+    double first = 0;
+    double last = 0;
+
+    fprintf(stdout, "%10s %16s\n", "args", "parse ns/arg");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        int n = sizes[s];
+        int count = 2 * n + 5;
+        char const **args = malloc(sizeof(char *) * count);
+        int pos = 0;
+        args[pos++] = "bench";
+        args[pos++] = "-o";
+        args[pos++] = "out";
+        args[pos++] = "-l";
+        for (int i = 0; i < n; ++i) {
+            args[pos++] = "list-value";
+        }
+        args[pos++] = "--";
+        for (int i = 0; i < n; ++i) {
+            args[pos++] = "positional-value";
+        }
+
+        parser_new(parser, "bench", "Scaling benchmark.");
+        add_flag_value(parser, output, 'o', "output", "PATH", "Output path.", SET_NONE);
+        add_flag_list(parser, list, 'l', "list", "VALUE", "List of values.", SET_NONE);
+        add_arg_list(parser, files, "FILES", "Positional values.");
+        add_command(parser, run, "run", "Unused subcommand, makes every value a command candidate.");
+
+        double start = now_ns();
+        if (parser_parse_args(parser, args, count) != 0) {
+            fprintf(stderr, "parse failed\n");
+            return 1;
+        }
+        double parse = now_ns() - start;
+        if (!flag_value_exists(output) || flag_list_count(list) != (size_t)n || arg_list_count(files) != (size_t)n ||
+            command_is_set(run) == 1) {
+            fprintf(stderr, "parse results differ from the commandline\n");
+            return 1;
+        }
+        fprintf(stdout, "%10d %16.1f\n", count, parse / count);
+        first = s == 0 ? parse / count : first;
+        last = parse / count;
+
+        parser_deinit(parser);
+        free(args);
+    }
+
+    if (last > MAX_RATIO * first) {
+        fprintf(stderr, "parse time per argument grew %.1fx, more than %.1fx\n", last / first, MAX_RATIO);
+        return 1;
+    }
+    return 0;
+}
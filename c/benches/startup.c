@@ -0,0 +1,102 @@
+/*
+ * Compares the startup of a generated parser with a parser built at runtime.
+ *
+ * The runtime parser registers the schema of startup.schema on every round, compiles it with the first parse and
+ * releases it again, just like a process does on every start. The generated parser only parses, its tables are
+ * constant data emitted by argparse-c-schema.
+ */
+#include "argparse.h"
+#include "startup.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#define ROUNDS 100000
+
+static char const *args[] = {"startup", "-v", "-C", "/tmp", "--config", "a=b", "commit", "-a", "-m", "msg", "x", "y"};
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/*!
+ * Registers the same schema as startup.schema
+ */
+static struct parser *build(void) {
+    struct parser *parser = parser_init("startup", "Startup benchmark schema.");
+    parser_add_flag(parser, 'v', "verbose", "Verbose output.");
+    parser_add_flag_value(parser, 'C', "directory", "PATH", "Run as if started in PATH.", SET_NONE);
+    parser_add_flag_value(parser, 'c', "config", "KEY=VALUE", "Configuration parameter.", SET_NONE);
+    parser_add_flag(parser, 'P', "no-pager", "Do not pipe into a pager.");
+    parser_add_flag_value(parser, 'w', "work-tree", "PATH", "Path to the working tree.", SET_NONE);
+    parser_add_flag_value(parser, 'g', "git-dir", "PATH", "Path to the repository.", SET_NONE);
+    parser_add_flag_value(parser, 'n', "namespace", "NAME", "Namespace.", SET_NONE);
+    parser_add_flag_value(parser, 'e', "exec-path", "PATH", "Path to the core programs.", SET_NONE);
+    parser_add_flag(parser, 'b', "bare", "Treat as bare repository.");
+    parser_add_flag(parser, 'l', "literal", "Treat pathspecs literally.");
+
+    struct command *clone = parser_add_command(parser, "clone", "Clones a repository.");
+    command_add_flag_value(clone, 'b', "branch", "NAME", "Branch to check out.", SET_NONE);
+    command_add_flag_value(clone, 'd', "depth", "N", "Depth of the history.", SET_NONE);
+    command_add_flag(clone, 'q', "quiet", "Suppress output.", SET_NONE);
+    command_add_flag(clone, 'r', "recursive", "Clone submodules.", SET_NONE);
+    command_add_arg_list(clone, "PATHS", "Paths.");
+
+    struct command *commit = parser_add_command(parser, "commit", "Records changes.");
+    command_add_flag_value(commit, 'm', "message", "MSG", "Commit message.", SET_NONE);
+    command_add_flag(commit, 'a', "all", "Stage all changes.", SET_NONE);
+    command_add_flag(commit, 's', "signoff", "Add signoff.", SET_NONE);
+    command_add_flag_value(commit, 'F', "file", "FILE", "Read message from file.", SET_NONE);
+    command_add_arg_list(commit, "PATHS", "Paths.");
+
+    struct command *log = parser_add_command(parser, "log", "Shows the history.");
+    command_add_flag_value(log, 'n', "max-count", "N", "Limit the number of commits.", SET_NONE);
+    command_add_flag(log, 'p', "patch", "Show the patch.", SET_NONE);
+    command_add_flag(log, 'g', "graph", "Draw the graph.", SET_NONE);
+    command_add_flag_value(log, 'A', "author", "NAME", "Filter by author.", SET_NONE);
+    command_add_arg_list(log, "PATHS", "Paths.");
+
+    struct command *push = parser_add_command(parser, "push", "Updates remote refs.");
+    command_add_flag(push, 'f', "force", "Force the update.", SET_NONE);
+    command_add_flag(push, 'u', "set-upstream", "Set upstream.", SET_NONE);
+    command_add_flag(push, 't', "tags", "Push tags.", SET_NONE);
+    command_add_flag_value(push, 'o', "push-option", "OPT", "Transmit option.", SET_NONE);
+    command_add_arg_list(push, "PATHS", "Paths.");
+    return parser;
+}
+
+int main(int argc, char **argv) {
+    int argn = sizeof(args) / sizeof(args[0]);
+    size_t checksum = 0;
+
+    double start = now_ns();
+    for (int i = 0; i < ROUNDS; ++i) {
+        struct parser *parser = build();
+        if (parser_parse_args(parser, args, argn) != 0) {
+            fprintf(stderr, "parse failed\n");
+            return 1;
+        }
+        checksum += (size_t)parser_error(parser);
+        parser_deinit(parser);
+    }
+    double runtime = (now_ns() - start) / ROUNDS;
+
+    start = now_ns();
+    for (int i = 0; i < ROUNDS; ++i) {
+        parser_reset(startup);
+        if (parser_parse_args(startup, args, argn) != 0) {
+            fprintf(stderr, "parse failed\n");
+            return 1;
+        }
+        checksum += (size_t)flag_count(startup_verbose) + arg_list_count(startup_commit_paths);
+    }
+    double generated = (now_ns() - start) / ROUNDS;
+
+    fprintf(stdout, "%-28s %12s\n", "parser", "ns/startup");
+    fprintf(stdout, "%-28s %12.1f\n", "parser_init + parse", runtime);
+    fprintf(stdout, "%-28s %12.1f\n", "generated (startup.schema)", generated);
+    fprintf(stdout, "%-28s %12.1fx\n", "speedup", runtime / generated);
+    return checksum == 0 ? 1 : 0;
+}
@@ -0,0 +1,76 @@
+/*
+ * Parses concurrently with one shared compiled parser.
+ *
+ * Every thread owns a parse result on its stack and parses the same commandline repeatedly. The throughput scales
+ * with the number of threads as the compiled parser is only read.
+ */
+#include "argparse.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+
+#define ROUNDS 1000000
+#define MAX_THREADS 8
+
+static char const *args[] = {"bench", "-v", "-o", "out", "run", "--jobs", "4", "a", "b", "c"};
+
+static struct parser *parser;
+static struct flag *verbose;
+static struct flag *jobs;
+static struct arg *files;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void *worker(void *data) {
+    _Alignas(max_align_t) char buffer[1024];
+    struct parse_result *result = parse_result_init(parser, buffer, sizeof(buffer));
+    size_t checksum = 0;
+    for (int i = 0; i < ROUNDS; ++i) {
+        parse_result_reset(result);
+        if (parser_parse_args_r(parser, result, args, sizeof(args) / sizeof(args[0])) != 0) {
+            fprintf(stderr, "parse failed\n");
+            return NULL;
+        }
+        checksum += (size_t)flag_count_r(result, verbose) + flag_value_get_r(result, jobs)[0] +
+                     arg_list_count_r(result, files);
+    }
+    *(size_t *)data = checksum;
+    return NULL;
+}
+
+int main(int argc, char **argv) {
+    parser = parser_init("bench", "Thread benchmark.");
+    verbose = parser_add_flag(parser, 'v', "verbose", "Verbose output.");
+    parser_add_flag_value(parser, 'o', "output", "PATH", "Output path.", SET_NONE);
+    struct command *run = parser_add_command(parser, "run", "Runs the files.");
+    jobs = command_add_flag_value(run, 'j', "jobs", "N", "Number of jobs.", SET_REQUIRED);
+    files = command_add_arg_list(run, "FILES", "Files to run.");
+    if (parser_compile(parser) != 0 || parse_result_size(parser) > 1024) {
+        fprintf(stderr, "compile failed\n");
+        return 1;
+    }
+
+    fprintf(stdout, "%8s %16s %16s\n", "threads", "parses/s", "ns/parse");
+    for (int n = 1; n <= MAX_THREADS; n *= 2) {
+        pthread_t threads[MAX_THREADS];
+        size_t checksums[MAX_THREADS] = {0};
+
+        double start = now_ns();
+        for (int t = 0; t < n; ++t) {
+            pthread_create(&threads[t], NULL, worker, &checksums[t]);
+        }
+        for (int t = 0; t < n; ++t) {
+            pthread_join(threads[t], NULL);
+        }
+        double elapsed = now_ns() - start;
+        fprintf(stdout, "%8d %16.0f %16.1f\n", n, (double)n * ROUNDS / elapsed * 1e9, elapsed / ROUNDS);
+    }
+
+    parser_deinit(parser);
+    return 0;
+}
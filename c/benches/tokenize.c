@@ -0,0 +1,81 @@
+/*
+ * Measures the throughput of an interactive console, lines per second split by line_tokenize(..) and parsed.
+ *
+ * Every round copies one of a few typical lines into a reused line buffer, tokenizes it in place and parses the words
+ * into a result on the stack. No memory is allocated per line.
+ */
+#include "argparse.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define ROUNDS 1000000
+
+static char const *lines[] = {
+    "run --jobs 4 a b c",
+    "-v -o 'output file' run -j 8 \"input with \\\"quotes\\\"\" plain\\ escaped # trailing comment",
+    "   run    --jobs  16   'a'  \"b\"   c   ",
+    "-vv --output /var/log/console.log run x y z",
+};
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+int main(void) {
+    parser_new(parser, "console", "Tokenizer benchmark.");
+    add_flag(parser, verbose, 'v', "verbose", "Verbosity.");
+    add_flag_value(parser, output, 'o', "output", "PATH", "Output path.", SET_NONE);
+    add_command(parser, run, "run", "Run the jobs.");
+    cmd_add_flag_value(run, jobs, 'j', "jobs", "N", "Number of jobs.", SET_NONE);
+    cmd_add_arg_list(run, files, "FILES", "Input files.");
+    if (parser_compile(parser) != 0) {
+        fprintf(stderr, "compile failed\n");
+        return 1;
+    }
+    (void)verbose, (void)output, (void)jobs, (void)files;
+
+    size_t count = sizeof(lines) / sizeof(lines[0]), lengths[sizeof(lines) / sizeof(lines[0])];
+    for (size_t i = 0; i < count; ++i) {
+        lengths[i] = strlen(lines[i]) + 1;
+    }
+
+    _Alignas(max_align_t) char buffer[1024];
+    struct parse_result *result = parse_result_init(parser, buffer, sizeof(buffer));
+    char line[256];
+    char const *argv[64] = {"console"};
+    size_t words = 0;
+
+    // Tokenizing only, then tokenizing and parsing every line
+    double tokenize = 0, parse = 0;
+    for (int pass = 0; pass < 2; ++pass) {
+        double start = now_ns();
+        for (int r = 0; r < ROUNDS; ++r) {
+            size_t i = (size_t)r % count;
+            memcpy(line, lines[i], lengths[i]);
+            int argc = line_tokenize(line, argv + 1, 63);
+            if (argc < 0) {
+                fprintf(stderr, "tokenize failed\n");
+                return 1;
+            }
+            words += (size_t)argc;
+            if (pass == 1) {
+                parse_result_reset(result);
+                if (parser_parse_args_r(parser, result, argv, argc + 1) != 0) {
+                    fprintf(stderr, "parse failed\n");
+                    return 1;
+                }
+            }
+        }
+        *(pass == 0 ? &tokenize : &parse) = now_ns() - start;
+    }
+
+    fprintf(stdout, "%16s %16s %16s\n", "", "lines/s", "ns/word");
+    fprintf(stdout, "%16s %16.0f %16.1f\n", "tokenize", ROUNDS / tokenize * 1e9, tokenize / (words / 2.0));
+    fprintf(stdout, "%16s %16.0f %16.1f\n", "tokenize+parse", ROUNDS / parse * 1e9, parse / (words / 2.0));
+    parser_deinit(parser);
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include "argparse.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+// Receives the arguments, values of the parse point into it
+static char buffer[1 << 16];
+
+int main(int argc, char const *const *argv) {
+    parser_new(parser, "cmdline", "Parses `cmdline /proc/<pid>/cmdline` or `printf '%s\\0' -v a b | cmdline`.");
+
+    add_flag(parser, verbose, 'v', "verbose", "Print every input.");
+    add_flag_value(parser, output, 'o', "output", "PATH", "Optional output file path.", SET_NONE);
+    add_arg_list(parser, inputs, "INPUTS", "Input files.");
+
+    int res = 1;
+    errno = 0;
+    if (argc > 1) {
+        // The file contains the program name followed by its arguments, each terminated by NUL
+        int fd = open(argv[1], O_RDONLY);
+        ssize_t size = 0;
+        for (ssize_t n = 1; fd >= 0 && n > 0 && (size_t)size < sizeof(buffer); size += n > 0 ? n : 0) {
+            n = read(fd, buffer + size, sizeof(buffer) - (size_t)size);
+        }
+        res = fd >= 0 ? parser_parse_buffer(parser, buffer, (size_t)size) : 1;
+        if (fd >= 0) {
+            close(fd);
+        }
+    } else {
+        // xargs -0 style input of the arguments only, read until the end of the stream
+        res = parser_parse_stream(parser, STDIN_FILENO, buffer, sizeof(buffer));
+    }
+    if (res != 0) {
+        if (errno != 0) {
+            fprintf(stderr, "Failed to read the arguments: %s\n", strerror(errno));
+        }
+        parser_deinit(parser);
+        return 1;
+    }
+
+    size_t offset = 0;
+    if (flag_value_offset(output, &offset) == 1) {
+        fprintf(stdout, "output - Offset %zu: %s\n", offset, buffer + offset);
+    }
+
+    // The values of a list follow each other in the buffer
+    size_t count = arg_list_count(inputs);
+    if (arg_list_offset(inputs, &offset) == 1) {
+        for (size_t i = 0; i < count && flag_count(verbose) > 0; ++i) {
+            fprintf(stdout, "INPUTS - Offset %zu: %s\n", offset, buffer + offset);
+            offset += strlen(buffer + offset) + 1;
+        }
+    }
+    fprintf(stdout, "INPUTS - Count: %zu\n", count);
+
+    parser_deinit(parser);
+    return 0;
+}
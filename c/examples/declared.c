@@ -0,0 +1,59 @@
+#include "argparse.h"
+#include "argparse_internal.h"
+
+#include <stdio.h>
+
+// Items of the parser, mirrors the parser of examples/flags.c
+#define DECLARED_ITEMS(X, P)                                                                                           \
+    X(P, FLAG, declared_verbose, 'v', "verbose", "Verbosity flag enabling more logging.")                              \
+    X(P, FLAG, declared_test, 't', "test", "Set testing flag.")                                                        \
+    X(P, VALUE, declared_output, 'o', "output", "PATH", "Optional output file path.", SET_REQUIRED)                    \
+    X(P, LIST, declared_files, 'l', "list", "FILE", "List of optional files.", SET_NONE)                               \
+    X(P, COMMAND, declared_run, "run", "The run subcommand.")
+
+#define DECLARED_RUN_ITEMS(X, P)                                                                                       \
+    X(P, VALUE, declared_flag, 'f', "flag", "FLAG", "Activate some flag.", SET_REQUIRED)                               \
+    X(P, COMMAND, declared_show, "show", "The show subcommand.")
+
+#define DECLARED_SHOW_ITEMS(X, P)                                                                                      \
+    X(P, FLAG, declared_what, 'w', "what", "What to show?")                                                            \
+    X(P, ARG, declared_input, "INPUT", "Input file path.")                                                             \
+    X(P, ARGS, declared_vars, "VARS", "Some variables.")
+
+#define DECLARED_COMMANDS(X, P)                                                                                        \
+    X(P, declared_run, DECLARED_RUN_ITEMS)                                                                             \
+    X(P, declared_show, DECLARED_SHOW_ITEMS)
+
+// The whole parser is constant data, only the parse results are written
+parser_define(declared, "declared", "Short description of the application and its use-case.", DECLARED_ITEMS,
+              DECLARED_COMMANDS)
+
+int main(int argc, char const *const *argv) {
+    if (0 != parser_parse_args(declared, argv, argc)) {
+        return 1;
+    }
+
+    fprintf(stdout, "verbose - Count: %d\n", flag_count(declared_verbose));
+    fprintf(stdout, "test - Count: %d\n", flag_count(declared_test));
+    if (flag_value_exists(declared_output)) {
+        fprintf(stdout, "output - Value: %s\n", flag_value_get(declared_output));
+    }
+
+    char const *const *values = flag_list_get(declared_files);
+    for (size_t i = 0; i < flag_list_count(declared_files); ++i) {
+        fprintf(stdout, "list - Item %zu: %s\n", i, values[i]);
+    }
+
+    if (command_is_set(declared_run) == 1) {
+        fprintf(stdout, "flag - Value: %s\n", flag_value_get(declared_flag));
+    }
+    if (command_is_set(declared_show) == 1) {
+        fprintf(stdout, "what - Count: %d\n", flag_count(declared_what));
+        fprintf(stdout, "INPUT - Value: %s\n", arg_value_get(declared_input));
+        values = arg_list_get(declared_vars);
+        for (size_t i = 0; i < arg_list_count(declared_vars); ++i) {
+            fprintf(stdout, "VARS - Item %zu: %s\n", i, values[i]);
+        }
+    }
+    return 0;
+}
@@ -37,15 +37,15 @@ int main(int argc, char const *const *argv) {
     }
 
     char const *const *values = flag_list_get(files);
-    for (int i = 0; i < flag_list_count(files); ++i) {
-        fprintf(stdout, "list - Item %d: %s\n", i, values[i]);
+    for (size_t i = 0; i < flag_list_count(files); ++i) {
+        fprintf(stdout, "list - Item %zu: %s\n", i, values[i]);
     }
 
     if (command_is_set(run) == 1) {
         fprintf(stdout, "flag - Count: %d\n", flag_count(flag));
         values = arg_list_get(vars);
-        for (int i = 0; i < arg_list_count(vars); ++i) {
-            fprintf(stdout, "VARS - Item %d: %s\n", i, values[i]);
+        for (size_t i = 0; i < arg_list_count(vars); ++i) {
+            fprintf(stdout, "VARS - Item %zu: %s\n", i, values[i]);
         }
     }
 
@@ -0,0 +1,32 @@
+#include "argparse.h"
+#include "generated.h"
+
+#include <stdio.h>
+
+int main(int argc, char const *const *argv) {
+    // The parser is declared in generated.schema, no construction needed
+    if (0 != parser_parse_args(generated, argv, argc)) {
+        return 1;
+    }
+
+    fprintf(stdout, "verbose - Count: %d\n", flag_count(generated_verbose));
+    fprintf(stdout, "test - Count: %d\n", flag_count(generated_test));
+    fprintf(stdout, "quiet - Count: %d\n", flag_count(generated_quiet));
+    if (flag_value_exists(generated_output)) {
+        fprintf(stdout, "output - Value: %s\n", flag_value_get(generated_output));
+    }
+
+    char const *const *values = flag_list_get(generated_files);
+    for (size_t i = 0; i < flag_list_count(generated_files); ++i) {
+        fprintf(stdout, "list - Item %zu: %s\n", i, values[i]);
+    }
+
+    if (command_is_set(generated_run) == 1) {
+        fprintf(stdout, "flag - Count: %d\n", flag_count(generated_flag));
+        values = arg_list_get(generated_vars);
+        for (size_t i = 0; i < arg_list_count(generated_vars); ++i) {
+            fprintf(stdout, "VARS - Item %zu: %s\n", i, values[i]);
+        }
+    }
+    return 0;
+}
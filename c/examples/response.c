@@ -0,0 +1,38 @@
+#include "argparse.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+int main(int argc, char const *const *argv) {
+    parser_new(parser, argv[0], "Reads its inputs from response files, e.g. `response -v @inputs.txt`.");
+
+    add_flag(parser, verbose, 'v', "verbose", "Print every input.");
+    add_arg_list(parser, inputs, "INPUTS", "Input files.");
+
+    // Arguments are expanded in place of the @file, nested response files are followed up to 8 levels
+    struct response *args = response_init(argv, argc, 8);
+    if (args == NULL) {
+        fprintf(stderr, "Failed to expand response files: %s\n", strerror(errno));
+        parser_deinit(parser);
+        return 1;
+    }
+
+    if (0 != parser_parse_args(parser, response_argv(args), response_argc(args))) {
+        response_deinit(args);
+        parser_deinit(parser);
+        return 1;
+    }
+
+    // The values point into the mapped response files and stay valid until response_deinit(..)
+    size_t count = arg_list_count(inputs);
+    char const *const *values = arg_list_get(inputs);
+    for (size_t i = 0; i < count && flag_count(verbose) > 0; ++i) {
+        fprintf(stdout, "INPUTS - Item %zu: %s\n", i, values[i]);
+    }
+    fprintf(stdout, "INPUTS - Count: %zu\n", count);
+
+    response_deinit(args);
+    parser_deinit(parser);
+    return 0;
+}
@@ -0,0 +1,29 @@
+#include "argparse.h"
+
+#include <stdio.h>
+
+int main(int argc, char const *const *argv) {
+    // All parser items are placed into this buffer, no heap allocation is performed
+    static _Alignas(max_align_t) char storage[2048];
+    parser_new_static(parser, storage, argv[0], "Application using a parser without heap allocations.");
+
+    add_flag(parser, verbose, 'v', "verbose", "Verbosity flag enabling more logging.");
+    add_flag_value(parser, output, 'o', "output", "PATH", "Optional output file path.", SET_NONE);
+
+    if (parser_error(parser) != ERR_NONE) {
+        fprintf(stderr, "Parser storage exhausted.\n");
+        return 1;
+    }
+
+    if (0 != parser_parse_args(parser, argv, argc)) {
+        return 1;
+    }
+
+    fprintf(stdout, "verbose - Count: %d\n", flag_count(verbose));
+    if (flag_value_exists(output)) {
+        fprintf(stdout, "output - Value: %s\n", flag_value_get(output));
+    }
+
+    parser_deinit(parser);
+    return 0;
+}
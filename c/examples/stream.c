@@ -0,0 +1,43 @@
+#include "argparse.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/*!
+ * Work done per input without keeping the list of inputs, here only the total size of the names
+ */
+struct ingest {
+    size_t files;
+    size_t bytes;
+};
+
+static void ingest_file(void *user, char const *value) {
+    struct ingest *ctx = user;
+    ctx->files += 1;
+    ctx->bytes += strlen(value);
+}
+
+static void print_include(void *user, char const *value) {
+    (void)user;
+    fprintf(stdout, "include - Value: %s\n", value);
+}
+
+int main(int argc, char const *const *argv) {
+    struct ingest ingest = {0, 0};
+    parser_new(parser, argv[0], "Processes every value while parsing, e.g. `stream -I inc ingest *.log`.");
+
+    add_flag_list_stream(parser, includes, 'I', "include", "DIR", "Include directories.", SET_NONE, print_include, NULL);
+    add_command(parser, run, "ingest", "Ingests the given files.");
+    command_add_arg_list_stream(run, "FILES", "Files to ingest.", ingest_file, &ingest);
+
+    // The callbacks are invoked during parsing, no list of values is kept
+    if (0 != parser_parse_args(parser, argv, argc)) {
+        parser_deinit(parser);
+        return 1;
+    }
+
+    fprintf(stdout, "include - Count: %zu\n", flag_list_count(includes));
+    fprintf(stdout, "FILES - Count: %zu, Bytes: %zu\n", ingest.files, ingest.bytes);
+    parser_deinit(parser);
+    return 0;
+}
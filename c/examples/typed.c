@@ -0,0 +1,38 @@
+#include "argparse.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+
+int main(int argc, char const *const *argv) {
+    parser_new(parser, argv[0], "Shows the typed accessors.");
+
+    // Values are converted once while parsing, invalid values fail the parse
+    add_flag_value_typed(parser, jobs, 'j', "jobs", "N", "Number of jobs.", SET_NONE, TYPE_U64);
+    add_flag_value_typed(parser, offset, 'o', "offset", "N", "Signed offset.", SET_NONE, TYPE_I64);
+    add_flag_value_typed(parser, scale, 's', "scale", "FACTOR", "Scale factor.", SET_NONE, TYPE_DOUBLE);
+    add_flag_value_typed(parser, color, 'c', "color", "BOOL", "Colored output.", SET_NONE, TYPE_BOOL);
+    add_flag_list_typed(parser, weights, 'w', "weights", "WEIGHT", "List of weights.", SET_NONE, TYPE_DOUBLE);
+
+    if (0 != parser_parse_args(parser, argv, argc)) {
+        return 1;
+    }
+
+    uint64_t n = 1;
+    int64_t o = 0;
+    double f = 1.0;
+    int c = 0;
+    flag_value_get_u64(jobs, &n);
+    flag_value_get_i64(offset, &o);
+    flag_value_get_double(scale, &f);
+    flag_value_get_bool(color, &c);
+    fprintf(stdout, "jobs: %" PRIu64 ", offset: %" PRId64 ", scale: %g, color: %d\n", n, o, f, c);
+
+    double values[16];
+    size_t count = flag_list_get_double(weights, values, sizeof(values) / sizeof(values[0]));
+    for (size_t i = 0; i < count; ++i) {
+        fprintf(stdout, "weights - Item %zu: %g\n", i, values[i]);
+    }
+
+    parser_deinit(parser);
+    return 0;
+}
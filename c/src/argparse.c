@@ -22,293 +22,1045 @@
  * SOFTWARE.
  *********************************************************************************************************************/
 
+// Exposes MAP_ANONYMOUS for the mappings of response files on strict ISO C builds
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE
+#endif
+
+#include <errno.h>
+#include <limits.h>
+#include <locale.h>
+#include <stdarg.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
+
+#ifndef ARGPARSE_NO_MALLOC
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 #include "argparse.h"
+#include "argparse_internal.h"
 
 /*********************************************************************************************************************
- * struct flag
+ * arena
  *********************************************************************************************************************/
 
-struct __attribute__((packed)) flag {
-    char _short;
-    unsigned int _count : 8;
-    unsigned int _flags : 8;
-    char const *_long;
-    char const *_placeholder;
-    char const *_desc;
-    char const *const *_values;
-
-    int (*takes)();
-    int (*parse)(struct flag *ctx, char const *const *, int);
-};
+#ifndef ARGPARSE_ARENA_BLOCK_SIZE
+#define ARGPARSE_ARENA_BLOCK_SIZE 4096
+#endif
 
-static void flag_init(struct flag *ctx, char const flag, char const *const l_flag, char const *const placeholder,
-                      char const *const desc, unsigned int flags, int (*takes)(),
-                      int (*parse)(struct flag *, char const *const *, int)) {
-    ctx->_short = flag;
-    ctx->_long = l_flag;
-    ctx->_flags = flags;
-    ctx->_placeholder = placeholder;
-    ctx->_desc = desc;
-    ctx->_count = 0;
-    ctx->_values = NULL;
-    ctx->takes = takes;
-    ctx->parse = parse;
+#define ARENA_ALIGN(size) (((size) + _Alignof(max_align_t) - 1) & ~(_Alignof(max_align_t) - 1))
+
+/*!
+ * Places the block header at the first aligned position of the given storage
+ */
+static struct arena_block *arena_block_place(void *buffer, size_t size) {
+    size_t skip = ARENA_ALIGN((uintptr_t)buffer) - (uintptr_t)buffer;
+    size_t header = ARENA_ALIGN(sizeof(struct arena_block));
+    if (buffer == NULL || size < skip + header) {
+        return NULL;
+    }
+    struct arena_block *block = (struct arena_block *)((char *)buffer + skip);
+    block->_next = NULL;
+    block->_size = size - skip;
+    block->_used = header;
+    return block;
+}
+
+#ifndef ARGPARSE_NO_MALLOC
+static struct arena_block *arena_block_new(size_t size) {
+    size_t header = ARENA_ALIGN(sizeof(struct arena_block));
+    if (size < ARGPARSE_ARENA_BLOCK_SIZE - header) {
+        size = ARGPARSE_ARENA_BLOCK_SIZE - header;
+    }
+    return arena_block_place(malloc(header + size), header + size);
+}
+#endif
+
+static void *arena_block_alloc(struct arena_block *block, size_t size) {
+    size = ARENA_ALIGN(size);
+    if (block == NULL || block->_size - block->_used < size) {
+        return NULL;
+    }
+    void *ptr = (char *)block + block->_used;
+    block->_used += size;
+    return ptr;
+}
+
+/*!
+ * Allocates without marking the arena exhausted on failure, used while parsing since parser_error(..) only reports
+ * failures while adding commands, flags or args
+ */
+static void *arena_try_alloc(struct arena *ctx, size_t size) {
+    void *ptr = arena_block_alloc(ctx->_head, size);
+#ifndef ARGPARSE_NO_MALLOC
+    if (ptr == NULL && ctx->_fixed == 0) {
+        // Grow geometrically to keep the number of blocks small for large schemas
+        size_t grow = ctx->_head != NULL ? ctx->_head->_size * 2 : 0;
+        struct arena_block *block = arena_block_new(ARENA_ALIGN(size) > grow ? ARENA_ALIGN(size) : grow);
+        if (block != NULL) {
+            block->_next = ctx->_head;
+            ctx->_head = block;
+            ptr = arena_block_alloc(block, size);
+        }
+    }
+#endif
+    return ptr;
+}
+
+static void *arena_alloc(struct arena *ctx, size_t size) {
+    void *ptr = arena_try_alloc(ctx, size);
+    if (ptr == NULL) {
+        ctx->_exhausted = 1;
+    }
+    return ptr;
+}
+
+static void arena_deinit(struct arena *ctx) {
+#ifndef ARGPARSE_NO_MALLOC
+    struct arena_block *block = ctx->_fixed == 0 ? ctx->_head : NULL;
+    while (block != NULL) {
+        struct arena_block *next = block->_next;
+        free(block);
+        block = next;
+    }
+#endif
+    ctx->_head = NULL;
 }
 
 /*********************************************************************************************************************
- * flag
+ * conversion
  *********************************************************************************************************************/
 
-static int flag_takes() { return 0; }
+static int convert_digit(char c) { return c >= '0' && c <= '9' ? c - '0' : -1; }
 
-static int flag_parse(struct flag *ctx, char const *const *argv, int argc) {
-    ctx->_count += 1;
+/*!
+ * Converts unsigned decimal digits up to the given limit, fails on empty input, trailing garbage and overflow
+ */
+static int convert_digits(char const *text, uint64_t limit, uint64_t *out) {
+    uint64_t value = 0;
+    if (*text == '\0') {
+        return -1;
+    }
+    for (; *text != '\0'; ++text) {
+        int d = convert_digit(*text);
+        if (d < 0 || value > (limit - (uint64_t)d) / 10) {
+            return -1;
+        }
+        value = value * 10 + (uint64_t)d;
+    }
+    *out = value;
     return 0;
 }
 
-int flag_count(struct flag *flag) {
-    if (flag != NULL) {
-        return flag->_count;
-    } else {
+static int convert_i64(char const *text, union number *out) {
+    int negative = *text == '-' ? 1 : 0;
+    uint64_t value = 0;
+    if (*text == '-' || *text == '+') {
+        ++text;
+    }
+    if (convert_digits(text, (uint64_t)INT64_MAX + (uint64_t)negative, &value) != 0) {
         return -1;
     }
+    out->_i64 = negative == 1 ? (int64_t)(0 - value) : (int64_t)value;
+    return 0;
 }
 
-int flag_set(struct flag *flag) {
-    if (flag != NULL) {
-        return flag->_count > 0 ? 1 : 0;
-    } else {
+static int convert_u64(char const *text, union number *out) {
+    return convert_digits(*text == '+' ? text + 1 : text, UINT64_MAX, &out->_u64);
+}
+
+/*!
+ * Converts a validated number with strtod(..), fails on overflow but accepts underflow to zero
+ */
+static int convert_strtod(char const *text, union number *out) {
+    errno = 0;
+    double value = strtod(text, NULL);
+    if (errno == ERANGE && (value > 1.0 || value < -1.0)) {
         return -1;
     }
+    out->_f64 = value;
+    return 0;
+}
+
+/*!
+ * Converts a decimal floating point number `[+-]digits[.digits][(e|E)[+-]digits]` independent of the locale.
+ * Numbers with at most 15 significant digits and a small exponent are converted exactly by a single multiplication
+ * or division, all others by strtod(..) with the decimal point of the current locale.
+ */
+static int convert_double(char const *text, union number *out) {
+    static double const powers[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    char const *it = text;
+    int negative = *it == '-' ? 1 : 0;
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int significant = 0;
+    long exponent = 0;
+    char const *point = NULL;
+
+    if (*it == '-' || *it == '+') {
+        ++it;
+    }
+    for (; convert_digit(*it) >= 0 || (*it == '.' && point == NULL); ++it) {
+        if (*it == '.') {
+            point = it;
+            continue;
+        }
+        digits += 1;
+        if (mantissa == 0 && *it == '0') {
+            // Leading zeros are not significant
+            exponent -= point != NULL ? 1 : 0;
+        } else if (significant < 19) {
+            mantissa = mantissa * 10 + (uint64_t)convert_digit(*it);
+            significant += 1;
+            exponent -= point != NULL ? 1 : 0;
+        } else {
+            // Digits beyond 19 only contribute to the magnitude, the slow path handles their rounding
+            significant += 1;
+            exponent += point != NULL ? 0 : 1;
+        }
+    }
+    if (digits == 0) {
+        return -1;
+    }
+    if (*it == 'e' || *it == 'E') {
+        ++it;
+        int exp_negative = *it == '-' ? 1 : 0;
+        long value = 0;
+        if (*it == '-' || *it == '+') {
+            ++it;
+        }
+        if (convert_digit(*it) < 0) {
+            return -1;
+        }
+        for (; convert_digit(*it) >= 0; ++it) {
+            value = value < 100000 ? value * 10 + convert_digit(*it) : value;
+        }
+        exponent += exp_negative == 1 ? -value : value;
+    }
+    if (*it != '\0') {
+        return -1;
+    }
+
+    if (significant <= 15 && exponent >= -22 && exponent <= 22) {
+        // Both the mantissa and the power of ten are exact, thus the result is correctly rounded
+        double value = (double)mantissa;
+        value = exponent < 0 ? value / powers[-exponent] : value * powers[exponent];
+        out->_f64 = negative == 1 ? -value : value;
+        return 0;
+    }
+
+    char const *decimal = localeconv()->decimal_point;
+    if (point == NULL || (decimal[0] == '.' && decimal[1] == '\0')) {
+        return convert_strtod(text, out);
+    }
+    // Replace the decimal point by the one of the current locale
+    char buffer[256];
+    size_t len = (size_t)(point - text);
+    size_t decimal_len = strlen(decimal);
+    size_t rest = strlen(point + 1);
+    if (len + decimal_len + rest >= sizeof(buffer)) {
+        return -1;
+    }
+    memcpy(buffer, text, len);
+    memcpy(buffer + len, decimal, decimal_len);
+    memcpy(buffer + len + decimal_len, point + 1, rest + 1);
+    return convert_strtod(buffer, out);
+}
+
+/*!
+ * Compares ASCII case-insensitive without consulting the locale
+ */
+static int convert_equals(char const *text, char const *word) {
+    for (; *word != '\0'; ++text, ++word) {
+        char c = *text >= 'A' && *text <= 'Z' ? (char)(*text - 'A' + 'a') : *text;
+        if (c != *word) {
+            return 0;
+        }
+    }
+    return *text == '\0' ? 1 : 0;
+}
+
+static int convert_bool(char const *text, union number *out) {
+    static char const *const truthy[] = {"1", "true", "yes", "on"};
+    static char const *const falsy[] = {"0", "false", "no", "off"};
+    for (size_t i = 0; i < sizeof(truthy) / sizeof(truthy[0]); ++i) {
+        if (convert_equals(text, truthy[i]) == 1) {
+            out->_bool = 1;
+            return 0;
+        } else if (convert_equals(text, falsy[i]) == 1) {
+            out->_bool = 0;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/*!
+ * Converts the text to the given type, the only conversion routine used for parsing and accessing values
+ */
+static int convert(unsigned char type, char const *text, union number *out) {
+    switch (type) {
+    case TYPE_I64:
+        return convert_i64(text, out);
+    case TYPE_U64:
+        return convert_u64(text, out);
+    case TYPE_DOUBLE:
+        return convert_double(text, out);
+    case TYPE_BOOL:
+        return convert_bool(text, out);
+    default:
+        return 0;
+    }
 }
 
 /*********************************************************************************************************************
- * flag_value
+ * name_index
  *********************************************************************************************************************/
 
-static int flag_value_takes() { return 1; }
+/*!
+ * FNV-1a hash of a null terminated name, the length is determined in the same pass
+ */
+static uint32_t name_hash(char const *name, size_t *len) {
+    uint32_t hash = 2166136261u;
+    char const *it = name;
+    while (*it != '\0') {
+        hash = (hash ^ (unsigned char)*it++) * 16777619u;
+    }
+    *len = (size_t)(it - name);
+    return hash;
+}
 
-static int flag_value_parse(struct flag *ctx, char const *const *argv, int argc) {
-    if (argc < 1 || ctx->_values != NULL || ctx->_count != 0) {
-        // Fail if option already parsed
-        return -1;
+/*!
+ * Returns the position of the name in the indexed arrays, or count if not found. Names without an index, as declared
+ * by parser_define(..), are scanned by length only since their hashes are not known at compile time.
+ */
+static size_t name_index_find(struct name_index const *ctx, char const *const *names, size_t const *lens,
+                              uint32_t const *hashes, size_t count, char const *name, size_t len, uint32_t hash) {
+    if (ctx->_entries == NULL) {
+        size_t i = 0;
+        while (i < count && (lens[i] != len || memcmp(names[i], name, len) != 0)) {
+            ++i;
+        }
+        return i;
+    }
+    for (size_t e = hash & ctx->_mask;; e = (e + 1) & ctx->_mask) {
+        unsigned int entry = ctx->_entries[e];
+        if (entry == 0) {
+            return count;
+        }
+        size_t i = entry - 1;
+        if (hashes[i] == hash && lens[i] == len && memcmp(names[i], name, len) == 0) {
+            return i;
+        }
+    }
+}
+
+/*********************************************************************************************************************
+ * long_prefix
+ *********************************************************************************************************************/
+
+/*!
+ * Long name of flag i, flags registered without long name sort first as empty name
+ */
+static char const *long_name(struct command_table const *t, size_t i) {
+    return t->_longs[i] != NULL ? t->_longs[i] : "";
+}
+
+/*!
+ * Flag index at position k of the long name order, the registration order if no sorted order was built
+ */
+static size_t long_at(struct command_table const *t, size_t k) {
+    return t->_long_order != NULL ? t->_long_order[k] : k;
+}
+
+/*!
+ * Returns the first position of the sorted long name order whose name is not less than the prefix
+ */
+static size_t long_lower_bound(struct command_table const *t, char const *prefix) {
+    size_t lo = 0;
+    size_t hi = t->_flag_count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (strcmp(long_name(t, t->_long_order[mid]), prefix) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/*!
+ * Resolves a prefix of a long flag. Returns the flag index if exactly one long name starts with the prefix, the first
+ * registered one if the name is registered several times. Returns count if no name matches and count + 1 if the
+ * prefix is ambiguous. With the sorted order, the candidate is found by binary search and only its next distinct
+ * neighbour is checked. Tables without the order, as declared by parser_define(..), are scanned linearly.
+ */
+static size_t long_prefix_find(struct command_table const *t, char const *prefix, size_t len) {
+    size_t count = t->_flag_count;
+    if (t->_long_order == NULL) {
+        size_t found = count;
+        for (size_t i = 0; i < count; ++i) {
+            if (strncmp(long_name(t, i), prefix, len) != 0) {
+                continue;
+            }
+            if (found == count) {
+                found = i;
+            } else if (strcmp(long_name(t, i), long_name(t, found)) != 0) {
+                return count + 1;
+            }
+        }
+        return found;
+    }
+
+    size_t k = long_lower_bound(t, prefix);
+    if (k == count || strncmp(long_name(t, t->_long_order[k]), prefix, len) != 0) {
+        return count;
+    }
+    size_t found = t->_long_order[k];
+    while (++k < count && strcmp(long_name(t, t->_long_order[k]), long_name(t, found)) == 0) {
+    }
+    if (k < count && strncmp(long_name(t, t->_long_order[k]), prefix, len) == 0) {
+        return count + 1;
+    }
+    return found;
+}
+
+/*!
+ * Reports every long name starting with the ambiguous prefix, each name once
+ */
+static void long_prefix_report(struct command_table const *t, char const *prefix, size_t len) {
+    size_t first = t->_long_order != NULL ? long_lower_bound(t, prefix) : 0;
+    fprintf(stderr, "Ambiguous option: --%s could be", prefix);
+    char const *sep = " ";
+    for (size_t k = first; k < t->_flag_count; ++k) {
+        char const *name = long_name(t, long_at(t, k));
+        if (strncmp(name, prefix, len) != 0) {
+            if (t->_long_order != NULL) {
+                break;
+            }
+            continue;
+        }
+        size_t j = first;
+        while (j < k && strcmp(long_name(t, long_at(t, j)), name) != 0) {
+            ++j;
+        }
+        if (j == k) {
+            fprintf(stderr, "%s--%s", sep, name);
+            sep = ", ";
+        }
+    }
+    fprintf(stderr, "\n");
+}
+
+/*********************************************************************************************************************
+ * struct flag, struct arg, struct command
+ *********************************************************************************************************************/
+
+static struct slot const empty_slot = {0, {NULL}, 0, 0, {{0}}};
+
+static void parse_result_place(struct parse_result *ctx, struct parser *parser, struct slot *slots, size_t count) {
+    ctx->_parser = parser;
+    ctx->_slot_count = count;
+    ctx->_slots = slots;
+    ctx->_gen = 1;
+    ctx->_help = NULL;
+    ctx->_buffer = NULL;
+    ctx->_chunks = NULL;
+    ctx->_chunks_free = NULL;
+    ctx->_spare = NULL;
+    ctx->_spare_size = 0;
+}
+
+/*!
+ * Returns the parse state of the given slot of an item of the root parser. Returns an empty state if the result
+ * belongs to another parser, the parser is not compiled yet or the slot belongs to a previous parse.
+ */
+static struct slot const *result_slot(struct parse_result const *ctx, struct parser const *root, size_t slot) {
+    if (ctx->_parser == root && ctx->_slots != NULL && ctx->_slots[slot]._gen == ctx->_gen) {
+        return &ctx->_slots[slot];
+    }
+    return &empty_slot;
+}
+
+/*!
+ * Returns the slot for writing, a slot of a previous parse is cleared first
+ */
+static struct slot *result_slot_claim(struct parse_result *ctx, size_t slot) {
+    struct slot *s = &ctx->_slots[slot];
+    if (s->_gen != ctx->_gen) {
+        s->_count = 0;
+        s->_values = NULL;
+        s->_chunks = NULL;
+        s->_converted = 0;
+        s->_gen = ctx->_gen;
+    }
+    return s;
+}
+
+/*!
+ * Returns the first value of the slot
+ */
+static char const *result_value(struct parse_result const *ctx, struct slot const *slot) {
+    return ctx->_buffer == NULL ? slot->_values[0] : slot->_first;
+}
+
+/*!
+ * Returns the value k of the run, prev is the value k - 1. Values of a buffer parse are consecutive arguments within
+ * the buffer, thus they are found by skipping the previous value.
+ */
+static char const *run_value(struct parse_result const *ctx, struct list_run const *run, size_t k, char const *prev) {
+    if (ctx->_buffer == NULL) {
+        return run->_values[k];
+    }
+    return k == 0 ? run->_first : prev + strlen(prev) + 1;
+}
+
+/*!
+ * Returns a chunk for the runs of a repeated list, reusing the chunks of previous parses first
+ */
+static struct list_chunk *result_chunk(struct parse_result *ctx) {
+    struct list_chunk *chunk = ctx->_chunks_free;
+    if (chunk != NULL) {
+        ctx->_chunks_free = chunk->_pool;
+    } else {
+        size_t size = ARENA_ALIGN(sizeof(struct list_chunk));
+        if (ctx->_spare_size >= size) {
+            chunk = (struct list_chunk *)ctx->_spare;
+            ctx->_spare += size;
+            ctx->_spare_size -= size;
+        } else if (ctx == &ctx->_parser->_result) {
+            chunk = arena_try_alloc(&ctx->_parser->_arena, sizeof(struct list_chunk));
+        }
+        if (chunk == NULL) {
+            return NULL;
+        }
+        // All chunks are in use, thus the new one is added in front of the pool
+        chunk->_pool = ctx->_chunks;
+        ctx->_chunks = chunk;
+    }
+    chunk->_next = NULL;
+    chunk->_last = chunk;
+    chunk->_count = 0;
+    return chunk;
+}
+
+/*!
+ * Returns the offset of the first value of the slot within the parsed buffer
+ */
+static int result_offset(struct parse_result const *ctx, struct slot const *slot, size_t *offset) {
+    if (ctx->_buffer == NULL || slot->_first == NULL) {
+        return ctx->_buffer == NULL ? -1 : 0;
+    }
+    if (offset != NULL) {
+        *offset = (size_t)(slot->_first - ctx->_buffer);
     }
-    ctx->_values = &argv[0];
-    ctx->_count = 1;
     return 1;
 }
 
-int flag_value_exists(struct flag *value) {
-    if (value != NULL) {
-        return value->_values != NULL;
+/*!
+ * Returns whether the schema is compiled and thus can't be extended anymore
+ */
+static int parser_is_compiled(struct parser *ctx) { return ctx->_result._slots != NULL ? 1 : 0; }
+
+/*********************************************************************************************************************
+ * list_iter
+ *********************************************************************************************************************/
+
+/*!
+ * Moves the iterator to the values of the run
+ */
+static void list_iter_load(struct list_iter *it, struct list_run const *run) {
+    if (it->_result->_buffer == NULL) {
+        it->_values = run->_values;
     } else {
-        return -1;
+        it->_value = run->_first;
     }
+    it->_left = run->_count;
 }
 
-char const *flag_value_get(struct flag *value) {
-    if (value != NULL) {
-        return *value->_values;
+/*!
+ * Starts the iteration over the values of a list, returns the number of values
+ */
+static size_t list_iter_init(struct list_iter *it, struct parse_result const *result, struct slot const *slot,
+                             unsigned char arity) {
+    it->_result = result;
+    it->_chunk = arity == ARITY_MANY ? slot->_chunks : NULL;
+    it->_run = 0;
+    it->_values = NULL;
+    it->_value = NULL;
+    it->_left = 0;
+    if (it->_chunk != NULL) {
+        list_iter_load(it, &it->_chunk->_runs[0]);
+    } else if (arity != ARITY_NONE && slot->_values != NULL) {
+        struct list_run run = {{slot->_values}, slot->_count};
+        list_iter_load(it, &run);
     } else {
+        return 0;
+    }
+    return slot->_count;
+}
+
+char const *list_iter_next(struct list_iter *it) {
+    if (it == NULL) {
         return NULL;
     }
+    while (it->_left == 0) {
+        // Continue with the next run of a repeated list
+        if (it->_chunk == NULL) {
+            return NULL;
+        }
+        if (++it->_run == it->_chunk->_count) {
+            it->_chunk = it->_chunk->_next;
+            it->_run = 0;
+            if (it->_chunk == NULL) {
+                return NULL;
+            }
+        }
+        list_iter_load(it, &it->_chunk->_runs[it->_run]);
+    }
+    it->_left -= 1;
+    if (it->_result->_buffer == NULL) {
+        return *it->_values++;
+    }
+    char const *value = it->_value;
+    it->_value += strlen(value) + 1;
+    return value;
 }
 
 /*********************************************************************************************************************
- * flag_list
+ * flag
  *********************************************************************************************************************/
 
-static int flag_list_takes() { return 1; }
+static void flag_init(struct flag *ctx, struct parser *root, char const flag, char const *const l_flag,
+                      char const *const placeholder, char const *const desc, unsigned int flags, unsigned char arity,
+                      unsigned char type) {
+    ctx->_short = flag;
+    ctx->_arity = arity;
+    ctx->_type = type;
+    ctx->_flags = flags;
+    ctx->_long_len = 0;
+    ctx->_long_hash = l_flag != NULL ? name_hash(l_flag, &ctx->_long_len) : 0;
+    ctx->_slot = 0;
+    ctx->_root = root;
+    ctx->_long = l_flag;
+    ctx->_placeholder = placeholder;
+    ctx->_desc = desc;
+    ctx->_on_value = NULL;
+    ctx->_user = NULL;
+}
 
-static int flag_list_parse(struct flag *ctx, char const *const *argv, int argc) {
-    if (argc < 1 || ctx->_values != NULL || ctx->_count != 0) {
-        // Fail if option already parsed
+int flag_count_r(struct parse_result const *result, struct flag *flag) {
+    if (result != NULL && flag != NULL) {
+        return (int)result_slot(result, flag->_root, flag->_slot)->_count;
+    } else {
         return -1;
     }
-    ctx->_values = &argv[0];
-    ctx->_count = argc;
-    return argc;
 }
 
-int flag_list_exists(struct flag *list) {
-    if (list != NULL) {
-        return list->_values != NULL && list->_count > 0 ? 1 : 0;
+int flag_set_r(struct parse_result const *result, struct flag *flag) {
+    if (result != NULL && flag != NULL) {
+        return result_slot(result, flag->_root, flag->_slot)->_count > 0 ? 1 : 0;
     } else {
         return -1;
     }
 }
 
-int flag_list_count(struct flag *list) {
-    if (list != NULL) {
-        return list->_count;
+int flag_count(struct flag *flag) { return flag_count_r(flag != NULL ? &flag->_root->_result : NULL, flag); }
+
+int flag_set(struct flag *flag) { return flag_set_r(flag != NULL ? &flag->_root->_result : NULL, flag); }
+
+/*********************************************************************************************************************
+ * flag_value
+ *********************************************************************************************************************/
+
+int flag_value_exists_r(struct parse_result const *result, struct flag *value) {
+    if (result != NULL && value != NULL) {
+        return result_slot(result, value->_root, value->_slot)->_values != NULL;
     } else {
         return -1;
     }
 }
 
-char const *const *flag_list_get(struct flag *list) {
-    if (list != NULL) {
-        return list->_values;
+char const *flag_value_get_r(struct parse_result const *result, struct flag *value) {
+    if (result != NULL && value != NULL) {
+        struct slot const *slot = result_slot(result, value->_root, value->_slot);
+        return slot->_values != NULL ? result_value(result, slot) : NULL;
     } else {
         return NULL;
     }
 }
 
+int flag_value_exists(struct flag *value) {
+    return flag_value_exists_r(value != NULL ? &value->_root->_result : NULL, value);
+}
+
+char const *flag_value_get(struct flag *value) {
+    return flag_value_get_r(value != NULL ? &value->_root->_result : NULL, value);
+}
+
+int flag_value_offset_r(struct parse_result const *result, struct flag *value, size_t *offset) {
+    if (result != NULL && value != NULL) {
+        return result_offset(result, result_slot(result, value->_root, value->_slot), offset);
+    } else {
+        return -1;
+    }
+}
+
+int flag_value_offset(struct flag *value, size_t *offset) {
+    return flag_value_offset_r(value != NULL ? &value->_root->_result : NULL, value, offset);
+}
+
 /*********************************************************************************************************************
- * struct arg
+ * flag_list
  *********************************************************************************************************************/
 
-struct __attribute__((packed)) arg {
-    char const *_name;
-    char const *_desc;
+int flag_list_exists_r(struct parse_result const *result, struct flag *list) {
+    if (result != NULL && list != NULL) {
+        return result_slot(result, list->_root, list->_slot)->_count > 0 ? 1 : 0;
+    } else {
+        return -1;
+    }
+}
 
-    unsigned int _count : 8;
-    char const *const *_values;
+size_t flag_list_count_r(struct parse_result const *result, struct flag *list) {
+    if (result != NULL && list != NULL) {
+        return result_slot(result, list->_root, list->_slot)->_count;
+    } else {
+        return 0;
+    }
+}
 
-    int (*takes)();
-    int (*parse)(struct arg *, char const *const *argv, int argc);
-};
+char const *const *flag_list_get_r(struct parse_result const *result, struct flag *list) {
+    if (result != NULL && list != NULL && result->_buffer == NULL) {
+        struct slot const *slot = result_slot(result, list->_root, list->_slot);
+        return list->_arity != ARITY_MANY || slot->_chunks == NULL ? slot->_values : NULL;
+    } else {
+        return NULL;
+    }
+}
+
+size_t flag_list_iter_r(struct parse_result const *result, struct flag *list, struct list_iter *it) {
+    if (result != NULL && list != NULL && it != NULL) {
+        return list_iter_init(it, result, result_slot(result, list->_root, list->_slot), list->_arity);
+    } else {
+        return 0;
+    }
+}
 
-static void arg_init(struct arg *ctx, char const *const name, char const *const desc, int (*takes)(),
-                     int (*parse)(struct arg *, char const *const *, int)) {
+int flag_list_exists(struct flag *list) {
+    return flag_list_exists_r(list != NULL ? &list->_root->_result : NULL, list);
+}
+
+size_t flag_list_count(struct flag *list) {
+    return flag_list_count_r(list != NULL ? &list->_root->_result : NULL, list);
+}
+
+char const *const *flag_list_get(struct flag *list) {
+    return flag_list_get_r(list != NULL ? &list->_root->_result : NULL, list);
+}
+
+size_t flag_list_iter(struct flag *list, struct list_iter *it) {
+    return flag_list_iter_r(list != NULL ? &list->_root->_result : NULL, list, it);
+}
+
+int flag_list_offset_r(struct parse_result const *result, struct flag *list, size_t *offset) {
+    if (result != NULL && list != NULL) {
+        return result_offset(result, result_slot(result, list->_root, list->_slot), offset);
+    } else {
+        return -1;
+    }
+}
+
+int flag_list_offset(struct flag *list, size_t *offset) {
+    return flag_list_offset_r(list != NULL ? &list->_root->_result : NULL, list, offset);
+}
+
+/*********************************************************************************************************************
+ * typed flag_value and flag_list
+ *********************************************************************************************************************/
+
+/*!
+ * Returns the value of a flag value as the given type. Values of flags registered with the same type were converted
+ * while parsing, all others are converted on access.
+ */
+static int flag_value_number(struct parse_result const *result, struct flag *value, unsigned char type,
+                             union number *out) {
+    if (result == NULL || value == NULL || value->_arity != ARITY_ONE) {
+        return -1;
+    }
+    struct slot const *slot = result_slot(result, value->_root, value->_slot);
+    if (slot->_values == NULL) {
+        return 0;
+    }
+    if (value->_type == type && slot->_converted) {
+        *out = slot->_number;
+        return 1;
+    }
+    return convert(type, result_value(result, slot), out) == 0 ? 1 : -1;
+}
+
+int flag_value_get_i64_r(struct parse_result const *result, struct flag *value, int64_t *out) {
+    union number number;
+    int res = flag_value_number(result, value, TYPE_I64, &number);
+    if (res == 1 && out != NULL) {
+        *out = number._i64;
+    }
+    return res;
+}
+
+int flag_value_get_u64_r(struct parse_result const *result, struct flag *value, uint64_t *out) {
+    union number number;
+    int res = flag_value_number(result, value, TYPE_U64, &number);
+    if (res == 1 && out != NULL) {
+        *out = number._u64;
+    }
+    return res;
+}
+
+int flag_value_get_double_r(struct parse_result const *result, struct flag *value, double *out) {
+    union number number;
+    int res = flag_value_number(result, value, TYPE_DOUBLE, &number);
+    if (res == 1 && out != NULL) {
+        *out = number._f64;
+    }
+    return res;
+}
+
+int flag_value_get_bool_r(struct parse_result const *result, struct flag *value, int *out) {
+    union number number;
+    int res = flag_value_number(result, value, TYPE_BOOL, &number);
+    if (res == 1 && out != NULL) {
+        *out = number._bool;
+    }
+    return res;
+}
+
+int flag_value_get_i64(struct flag *value, int64_t *out) {
+    return flag_value_get_i64_r(value != NULL ? &value->_root->_result : NULL, value, out);
+}
+
+int flag_value_get_u64(struct flag *value, uint64_t *out) {
+    return flag_value_get_u64_r(value != NULL ? &value->_root->_result : NULL, value, out);
+}
+
+int flag_value_get_double(struct flag *value, double *out) {
+    return flag_value_get_double_r(value != NULL ? &value->_root->_result : NULL, value, out);
+}
+
+int flag_value_get_bool(struct flag *value, int *out) {
+    return flag_value_get_bool_r(value != NULL ? &value->_root->_result : NULL, value, out);
+}
+
+/*!
+ * Converts the values of a flag list into the caller-provided array of elements with the given size, stops at the
+ * first value failing to convert. All members of union number start at its first byte.
+ */
+static size_t flag_list_numbers(struct parse_result const *result, struct flag *list, unsigned char type,
+                                void *values, size_t elem, size_t size) {
+    if (result == NULL || list == NULL || values == NULL) {
+        return 0;
+    }
+    struct list_iter it;
+    size_t count = list_iter_init(&it, result, result_slot(result, list->_root, list->_slot), list->_arity);
+    count = count < size ? count : size;
+    union number number;
+    for (size_t i = 0; i < count; ++i) {
+        if (convert(type, list_iter_next(&it), &number) != 0) {
+            return i;
+        }
+        memcpy((char *)values + i * elem, &number, elem);
+    }
+    return count;
+}
+
+size_t flag_list_get_i64_r(struct parse_result const *result, struct flag *list, int64_t *values, size_t size) {
+    return flag_list_numbers(result, list, TYPE_I64, values, sizeof(*values), size);
+}
+
+size_t flag_list_get_u64_r(struct parse_result const *result, struct flag *list, uint64_t *values, size_t size) {
+    return flag_list_numbers(result, list, TYPE_U64, values, sizeof(*values), size);
+}
+
+size_t flag_list_get_double_r(struct parse_result const *result, struct flag *list, double *values, size_t size) {
+    return flag_list_numbers(result, list, TYPE_DOUBLE, values, sizeof(*values), size);
+}
+
+size_t flag_list_get_bool_r(struct parse_result const *result, struct flag *list, int *values, size_t size) {
+    return flag_list_numbers(result, list, TYPE_BOOL, values, sizeof(*values), size);
+}
+
+size_t flag_list_get_i64(struct flag *list, int64_t *values, size_t size) {
+    return flag_list_get_i64_r(list != NULL ? &list->_root->_result : NULL, list, values, size);
+}
+
+size_t flag_list_get_u64(struct flag *list, uint64_t *values, size_t size) {
+    return flag_list_get_u64_r(list != NULL ? &list->_root->_result : NULL, list, values, size);
+}
+
+size_t flag_list_get_double(struct flag *list, double *values, size_t size) {
+    return flag_list_get_double_r(list != NULL ? &list->_root->_result : NULL, list, values, size);
+}
+
+size_t flag_list_get_bool(struct flag *list, int *values, size_t size) {
+    return flag_list_get_bool_r(list != NULL ? &list->_root->_result : NULL, list, values, size);
+}
+
+/*********************************************************************************************************************
+ * arg
+ *********************************************************************************************************************/
+
+static void arg_init(struct arg *ctx, struct parser *root, char const *const name, char const *const desc,
+                     unsigned char arity) {
+    ctx->_arity = arity;
+    ctx->_slot = 0;
+    ctx->_root = root;
     ctx->_name = name;
     ctx->_desc = desc;
-    ctx->_count = 0;
-    ctx->_values = NULL;
-    ctx->takes = takes;
-    ctx->parse = parse;
+    ctx->_on_value = NULL;
+    ctx->_user = NULL;
 }
 
 /*********************************************************************************************************************
  * arg_value
  *********************************************************************************************************************/
 
-static int arg_value_takes() { return 1; }
-
-static int arg_value_parse(struct arg *ctx, char const *const *argv, int argc) {
-    if (argc < 1 || ctx->_values != NULL || ctx->_count != 0) {
-        // Fail if required already parsed
-        return -1;
+char const *arg_value_get_r(struct parse_result const *result, struct arg *value) {
+    if (result != NULL && value != NULL) {
+        struct slot const *slot = result_slot(result, value->_root, value->_slot);
+        return slot->_values != NULL ? result_value(result, slot) : NULL;
+    } else {
+        return NULL;
     }
-    ctx->_values = &argv[0];
-    ctx->_count = 1;
-    return 1;
 }
 
 char const *const arg_value_get(struct arg *value) {
-    if (value != NULL) {
-        return *value->_values;
+    return arg_value_get_r(value != NULL ? &value->_root->_result : NULL, value);
+}
+
+int arg_value_offset_r(struct parse_result const *result, struct arg *value, size_t *offset) {
+    if (result != NULL && value != NULL) {
+        return result_offset(result, result_slot(result, value->_root, value->_slot), offset);
     } else {
-        return NULL;
+        return -1;
     }
 }
 
+int arg_value_offset(struct arg *value, size_t *offset) {
+    return arg_value_offset_r(value != NULL ? &value->_root->_result : NULL, value, offset);
+}
+
 /*********************************************************************************************************************
  * arg_list
  *********************************************************************************************************************/
 
-static int arg_list_takes() { return 2; }
-
-static int arg_list_parse(struct arg *ctx, char const *const *argv, int argc) {
-    if (argc < 1 || ctx->_values != NULL || ctx->_count != 0) {
-        // Fail if required already parsed
-        return -1;
+size_t arg_list_count_r(struct parse_result const *result, struct arg *list) {
+    if (result != NULL && list != NULL) {
+        return result_slot(result, list->_root, list->_slot)->_count;
+    } else {
+        return 0;
     }
-    ctx->_values = &argv[0];
-    ctx->_count = argc;
-    return 1;
 }
 
-int arg_list_count(struct arg *list) {
-    if (list != NULL) {
-        return list->_count;
+char const *const *arg_list_get_r(struct parse_result const *result, struct arg *list) {
+    if (result != NULL && list != NULL && result->_buffer == NULL) {
+        return result_slot(result, list->_root, list->_slot)->_values;
     } else {
-        return -1;
+        return NULL;
     }
 }
 
+size_t arg_list_count(struct arg *list) { return arg_list_count_r(list != NULL ? &list->_root->_result : NULL, list); }
+
 char const *const *arg_list_get(struct arg *list) {
-    if (list != NULL) {
-        return list->_values;
+    return arg_list_get_r(list != NULL ? &list->_root->_result : NULL, list);
+}
+
+size_t arg_list_iter_r(struct parse_result const *result, struct arg *list, struct list_iter *it) {
+    if (result != NULL && list != NULL && it != NULL) {
+        return list_iter_init(it, result, result_slot(result, list->_root, list->_slot), list->_arity);
     } else {
-        return NULL;
+        return 0;
     }
 }
 
-/*********************************************************************************************************************
- * command
- *********************************************************************************************************************/
+size_t arg_list_iter(struct arg *list, struct list_iter *it) {
+    return arg_list_iter_r(list != NULL ? &list->_root->_result : NULL, list, it);
+}
 
-struct flag_item;
-struct arg_item;
-struct command_item;
+int arg_list_offset_r(struct parse_result const *result, struct arg *list, size_t *offset) {
+    if (result != NULL && list != NULL) {
+        return result_offset(result, result_slot(result, list->_root, list->_slot), offset);
+    } else {
+        return -1;
+    }
+}
 
-struct __attribute__((packed)) command {
-    char const *_name;
-    char const *_desc;
-    unsigned int _set : 1;
+int arg_list_offset(struct arg *list, size_t *offset) {
+    return arg_list_offset_r(list != NULL ? &list->_root->_result : NULL, list, offset);
+}
 
-    struct command *_parent;
-    struct flag_item *_optionals;
-    struct arg_item *_requires;
-    struct command_item *_commands;
-};
+/*********************************************************************************************************************
+ * command
+ *********************************************************************************************************************/
 
-static void command_init(struct command *ctx, char const *const name, char const *const desc, struct command *parent) {
+static void command_init(struct command *ctx, char const *const name, char const *const desc, struct parser *root,
+                         struct command *parent) {
     ctx->_name = name;
     ctx->_desc = desc;
-    ctx->_set = 0;
+    ctx->_name_len = 0;
+    ctx->_name_hash = name != NULL ? name_hash(name, &ctx->_name_len) : 0;
+    ctx->_slot = 0;
+    ctx->_root = root;
     ctx->_parent = parent;
     ctx->_optionals = NULL;
     ctx->_requires = NULL;
     ctx->_commands = NULL;
+    ctx->_optionals_last = NULL;
+    ctx->_requires_last = NULL;
+    ctx->_commands_last = NULL;
+    ctx->_table = NULL;
 }
 
-int command_is_set(struct command *ctx) { return ctx->_set; }
+int command_is_set_r(struct parse_result const *result, struct command *ctx) {
+    if (result != NULL && ctx != NULL) {
+        return result_slot(result, ctx->_root, ctx->_slot)->_count > 0 ? 1 : 0;
+    } else {
+        return -1;
+    }
+}
+
+int command_is_set(struct command *ctx) { return command_is_set_r(ctx != NULL ? &ctx->_root->_result : NULL, ctx); }
 
 /*********************************************************************************************************************
  * flag_item
  *********************************************************************************************************************/
 
-struct __attribute__((packed)) flag_item {
-    struct flag _optional;
-    struct flag_item *_next;
-};
-
-static struct flag_item *flag_item_new(char const flag, char const *const l_flag, char const *const placeholder,
-                                       char const *const desc, unsigned int flags, int (*takes)(),
-                                       int (*parse)(struct flag *, char const *const *, int)) {
-    struct flag_item *ctx = malloc(sizeof(struct flag_item));
-    if (ctx != NULL) {
-        flag_init(&ctx->_optional, flag, l_flag, placeholder, desc, flags, takes, parse);
-        ctx->_next = NULL;
-    }
-    return ctx;
-}
-
 static struct flag *command_add_flag_item(struct command *ctx, char const flag, char const *const l_flag,
                                           char const *const placeholder, char const *const desc, unsigned int flags,
-                                          int (*takes)(), int (*parse)(struct flag *, char const *const *, int)) {
-    if (ctx == NULL) {
+                                          unsigned char arity, unsigned char type) {
+    if (ctx == NULL || parser_is_compiled(ctx->_root)) {
         return NULL;
     }
 
-    struct flag_item *item = flag_item_new(flag, l_flag, placeholder, desc, flags, takes, parse);
+    struct flag_item *item = arena_alloc(&ctx->_root->_arena, sizeof(struct flag_item));
     if (item != NULL) {
+        flag_init(&item->_optional, ctx->_root, flag, l_flag, placeholder, desc, flags, arity, type);
+        item->_next = NULL;
         if (ctx->_optionals == NULL) {
             ctx->_optionals = item;
         } else {
-            struct flag_item *it = ctx->_optionals;
-            while (it->_next != NULL) {
-                it = it->_next;
-            }
-            it->_next = item;
+            ctx->_optionals_last->_next = item;
         }
+        ctx->_optionals_last = item;
         return &item->_optional;
     } else {
         return NULL;
@@ -319,106 +1071,47 @@ static struct flag *command_add_flag_item(struct command *ctx, char const flag,
  * arg_item
  *********************************************************************************************************************/
 
-struct __attribute__((packed)) arg_item {
-    struct arg _required;
-    struct arg_item *_next;
-};
-
-static struct arg_item *arg_item_new(char const *const name, char const *const desc, int (*takes)(),
-                                     int (*parse)(struct arg *, char const *const *, int)) {
-    struct arg_item *ctx = malloc(sizeof(struct arg_item));
-    if (ctx != NULL) {
-        arg_init(&ctx->_required, name, desc, takes, parse);
-        ctx->_next = NULL;
-    }
-    return ctx;
-}
-
 static struct arg *command_add_arg_item(struct command *ctx, char const *const name, char const *const desc,
-                                        int (*takes)(), int (*parse)(struct arg *, char const *const *, int)) {
-    if (ctx == NULL) {
+                                        unsigned char arity) {
+    if (ctx == NULL || parser_is_compiled(ctx->_root)) {
         return NULL;
     }
 
-    struct arg_item *item = arg_item_new(name, desc, takes, parse);
+    struct arg_item *item = arena_alloc(&ctx->_root->_arena, sizeof(struct arg_item));
     if (item != NULL) {
+        arg_init(&item->_required, ctx->_root, name, desc, arity);
+        item->_next = NULL;
         if (ctx->_requires == NULL) {
             ctx->_requires = item;
         } else {
-            struct arg_item *it = ctx->_requires;
-            while (it->_next != NULL) {
-                it = it->_next;
-            }
-            it->_next = item;
+            ctx->_requires_last->_next = item;
         }
+        ctx->_requires_last = item;
         return &item->_required;
-    } else {
-        return NULL;
-    }
-}
-
-/*********************************************************************************************************************
- * command_item
- *********************************************************************************************************************/
-
-struct __attribute__((packed)) command_item {
-    struct command _command;
-    struct command_item *_next;
-};
-
-static void command_deinit(struct command *ctx) {
-    ctx->_name = NULL;
-    ctx->_desc = NULL;
-    ctx->_parent = NULL;
-
-    struct command_item *c = ctx->_commands;
-    while (c != NULL) {
-        ctx->_commands = c->_next;
-        command_deinit(&c->_command);
-        free(c);
-        c = ctx->_commands;
-    }
-
-    struct flag_item *o = ctx->_optionals;
-    while (o != NULL) {
-        ctx->_optionals = o->_next;
-        free(o);
-        o = ctx->_optionals;
-    }
-
-    struct arg_item *r = ctx->_requires;
-    while (r != NULL) {
-        ctx->_requires = r->_next;
-        free(r);
-        r = ctx->_requires;
+    } else {
+        return NULL;
     }
 }
 
-static struct command_item *command_item_new(char const *const name, char const *const desc, struct command *parent) {
-    struct command_item *ctx = malloc(sizeof(struct command_item));
-    if (ctx != NULL) {
-        command_init(&ctx->_command, name, desc, parent);
-        ctx->_next = NULL;
-    }
-    return ctx;
-}
+/*********************************************************************************************************************
+ * command_item
+ *********************************************************************************************************************/
 
 static struct command *command_add_command_item(struct command *ctx, char const *const name, char const *const desc) {
-    if (ctx == NULL) {
+    if (ctx == NULL || parser_is_compiled(ctx->_root)) {
         return NULL;
     }
 
-    struct command_item *item = command_item_new(name, desc, ctx);
+    struct command_item *item = arena_alloc(&ctx->_root->_arena, sizeof(struct command_item));
     if (item != NULL) {
+        command_init(&item->_command, name, desc, ctx->_root, ctx);
+        item->_next = NULL;
         if (ctx->_commands == NULL) {
             ctx->_commands = item;
         } else {
-            struct command_item *it = ctx->_commands;
-            while (it->_next != NULL) {
-                it = it->_next;
-            }
-            it->_next = item;
+            ctx->_commands_last->_next = item;
         }
+        ctx->_commands_last = item;
         return &item->_command;
     } else {
         return NULL;
@@ -435,63 +1128,389 @@ struct command *command_add_subcommand(struct command *ctx, char const *const na
 
 struct flag *command_add_flag(struct command *ctx, char const flag, char const *const l_flag, char const *const desc,
                               unsigned int flags) {
-    return command_add_flag_item(ctx, flag, l_flag, NULL, desc, flags, flag_takes, flag_parse);
+    return command_add_flag_item(ctx, flag, l_flag, NULL, desc, flags, ARITY_NONE, TYPE_STRING);
 }
 
 struct flag *command_add_flag_value(struct command *ctx, char const flag, char const *const l_flag,
                                     char const *const placeholder, char const *const desc, unsigned int flags) {
-    return command_add_flag_item(ctx, flag, l_flag, placeholder, desc, flags, flag_value_takes, flag_value_parse);
+    return command_add_flag_item(ctx, flag, l_flag, placeholder, desc, flags, ARITY_ONE, TYPE_STRING);
 }
 
 struct flag *command_add_flag_list(struct command *ctx, char const flag, char const *const l_flag,
                                    char const *const placeholder, char const *const desc, unsigned int flags) {
-    return command_add_flag_item(ctx, flag, l_flag, placeholder, desc, flags, flag_list_takes, flag_list_parse);
+    return command_add_flag_item(ctx, flag, l_flag, placeholder, desc, flags, ARITY_MANY, TYPE_STRING);
+}
+
+struct flag *command_add_flag_value_typed(struct command *ctx, char const flag, char const *const l_flag,
+                                          char const *const placeholder, char const *const desc, unsigned int flags,
+                                          enum types type) {
+    return command_add_flag_item(ctx, flag, l_flag, placeholder, desc, flags, ARITY_ONE, (unsigned char)type);
+}
+
+struct flag *command_add_flag_list_typed(struct command *ctx, char const flag, char const *const l_flag,
+                                         char const *const placeholder, char const *const desc, unsigned int flags,
+                                         enum types type) {
+    return command_add_flag_item(ctx, flag, l_flag, placeholder, desc, flags, ARITY_MANY, (unsigned char)type);
 }
 
 struct arg *command_add_arg_value(struct command *ctx, char const *const name, char const *const desc) {
-    return command_add_arg_item(ctx, name, desc, arg_value_takes, arg_value_parse);
+    return command_add_arg_item(ctx, name, desc, ARITY_ONE);
 }
 
 struct arg *command_add_arg_list(struct command *ctx, char const *const name, char const *const desc) {
-    return command_add_arg_item(ctx, name, desc, arg_list_takes, arg_list_parse);
+    return command_add_arg_item(ctx, name, desc, ARITY_MANY);
+}
+
+struct flag *command_add_flag_list_stream(struct command *ctx, char const flag, char const *const l_flag,
+                                          char const *const placeholder, char const *const desc, unsigned int flags,
+                                          void (*on_value)(void *user, char const *value), void *user) {
+    if (on_value == NULL) {
+        return NULL;
+    }
+    struct flag *list = command_add_flag_item(ctx, flag, l_flag, placeholder, desc, flags, ARITY_MANY, TYPE_STRING);
+    if (list != NULL) {
+        list->_on_value = on_value;
+        list->_user = user;
+    }
+    return list;
+}
+
+struct arg *command_add_arg_list_stream(struct command *ctx, char const *const name, char const *const desc,
+                                        void (*on_value)(void *user, char const *value), void *user) {
+    if (on_value == NULL) {
+        return NULL;
+    }
+    struct arg *list = command_add_arg_item(ctx, name, desc, ARITY_MANY);
+    if (list != NULL) {
+        list->_on_value = on_value;
+        list->_user = user;
+    }
+    return list;
+}
+
+/*********************************************************************************************************************
+ * Compiled command tables
+ *********************************************************************************************************************/
+
+/*!
+ * Allocates a zeroed array from the parser arena, returns non-NULL for empty arrays to simplify error handling
+ */
+static void *command_table_array(struct parser *root, size_t count, size_t size) {
+    void *ptr = arena_alloc(&root->_arena, count > 0 ? count * size : 1);
+    if (ptr != NULL) {
+        memset(ptr, 0, count * size);
+    }
+    return ptr;
+}
+
+/*!
+ * Builds the hash index over count names, the index is at most half full to keep probe sequences short
+ */
+static int name_index_build(struct parser *root, struct name_index *ctx, uint32_t const *hashes, size_t count) {
+    ctx->_mask = 0;
+    ctx->_entries = NULL;
+    if (count == 0) {
+        return 0;
+    }
+
+    size_t size = 4;
+    while (size < count * 2) {
+        size *= 2;
+    }
+    unsigned int *entries = command_table_array(root, size, sizeof(unsigned int));
+    if (entries == NULL) {
+        return -1;
+    }
+
+    // Insert in registration order, thus the first registered name is found first
+    for (size_t i = 0; i < count; ++i) {
+        size_t e = hashes[i] & (size - 1);
+        while (entries[e] != 0) {
+            e = (e + 1) & (size - 1);
+        }
+        entries[e] = (unsigned int)(i + 1);
+    }
+    ctx->_mask = size - 1;
+    ctx->_entries = entries;
+    return 0;
+}
+
+/*!
+ * Returns whether flag a precedes flag b in the long name order
+ */
+static int long_order_before(char const *const *longs, unsigned int a, unsigned int b) {
+    int c = strcmp(longs[a] != NULL ? longs[a] : "", longs[b] != NULL ? longs[b] : "");
+    return c < 0 || (c == 0 && a < b);
+}
+
+static void long_order_sift(char const *const *longs, unsigned int *order, size_t root, size_t count) {
+    for (size_t child = root * 2 + 1; child < count; root = child, child = root * 2 + 1) {
+        if (child + 1 < count && long_order_before(longs, order[child], order[child + 1])) {
+            ++child;
+        }
+        if (!long_order_before(longs, order[root], order[child])) {
+            return;
+        }
+        unsigned int tmp = order[root];
+        order[root] = order[child];
+        order[child] = tmp;
+    }
+}
+
+/*!
+ * Sorts the flag indices by long name in place using heapsort, thus without additional memory
+ */
+static void long_order_build(char const *const *longs, unsigned int *order, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        order[i] = (unsigned int)i;
+    }
+    for (size_t i = count / 2; i-- > 0;) {
+        long_order_sift(longs, order, i, count);
+    }
+    for (size_t end = count; end-- > 1;) {
+        unsigned int tmp = order[0];
+        order[0] = order[end];
+        order[end] = tmp;
+        long_order_sift(longs, order, 0, end);
+    }
+}
+
+/*!
+ * Compiles the tables of the command and all its subcommands, assigns the slots of all items
+ */
+static int command_compile(struct command *ctx, size_t *slots) {
+    struct parser *root = ctx->_root;
+    struct command_table *t = arena_alloc(&root->_arena, sizeof(struct command_table));
+    if (t == NULL) {
+        return -1;
+    }
+    memset(t, 0, sizeof(struct command_table));
+
+    for (struct flag_item *o = ctx->_optionals; o != NULL; o = o->_next) {
+        t->_flag_count += 1;
+    }
+    for (struct arg_item *r = ctx->_requires; r != NULL; r = r->_next) {
+        t->_arg_count += 1;
+    }
+    for (struct command_item *c = ctx->_commands; c != NULL; c = c->_next) {
+        t->_command_count += 1;
+    }
+
+    // Filled through local pointers, the tables are read-only once compiled
+    char const **longs = command_table_array(root, t->_flag_count, sizeof(char const *));
+    size_t *long_lens = command_table_array(root, t->_flag_count, sizeof(size_t));
+    uint32_t *long_hashes = command_table_array(root, t->_flag_count, sizeof(uint32_t));
+    unsigned char *arities = command_table_array(root, t->_flag_count, sizeof(unsigned char));
+    unsigned char *settings = command_table_array(root, t->_flag_count, sizeof(unsigned char));
+    unsigned char *types = command_table_array(root, t->_flag_count, sizeof(unsigned char));
+    struct flag **flags = command_table_array(root, t->_flag_count, sizeof(struct flag *));
+    unsigned char *arg_arities = command_table_array(root, t->_arg_count, sizeof(unsigned char));
+    struct arg **args = command_table_array(root, t->_arg_count, sizeof(struct arg *));
+    char const **names = command_table_array(root, t->_command_count, sizeof(char const *));
+    size_t *name_lens = command_table_array(root, t->_command_count, sizeof(size_t));
+    uint32_t *name_hashes = command_table_array(root, t->_command_count, sizeof(uint32_t));
+    struct command **commands = command_table_array(root, t->_command_count, sizeof(struct command *));
+    if (root->_arena._exhausted == 1) {
+        return -1;
+    }
+    t->_longs = longs;
+    t->_long_lens = long_lens;
+    t->_long_hashes = long_hashes;
+    t->_arities = arities;
+    t->_settings = settings;
+    t->_types = types;
+    t->_flags = flags;
+    t->_arg_arities = arg_arities;
+    t->_args = args;
+    t->_names = names;
+    t->_name_lens = name_lens;
+    t->_name_hashes = name_hashes;
+    t->_commands = commands;
+
+    // Slots of a command are contiguous: flags, args and the command itself
+    t->_slot_base = *slots;
+
+    size_t i = 0;
+    for (struct flag_item *o = ctx->_optionals; o != NULL; o = o->_next, ++i) {
+        struct flag *f = &o->_optional;
+        unsigned char c = (unsigned char)f->_short;
+        if (c > 0 && c < 128 && t->_short_index[c] == 0) {
+            t->_short_index[c] = i + 1;
+        }
+        longs[i] = f->_long;
+        long_lens[i] = f->_long_len;
+        long_hashes[i] = f->_long_hash;
+        arities[i] = f->_arity;
+        settings[i] = (unsigned char)f->_flags;
+        types[i] = f->_type;
+        flags[i] = f;
+        f->_slot = (*slots)++;
+    }
+
+    if (name_index_build(root, &t->_long_index, t->_long_hashes, t->_flag_count) != 0) {
+        return -1;
+    }
+    if (root->_abbrev == 1) {
+        unsigned int *order = command_table_array(root, t->_flag_count, sizeof(unsigned int));
+        if (order == NULL) {
+            return -1;
+        }
+        long_order_build(t->_longs, order, t->_flag_count);
+        t->_long_order = order;
+    }
+
+    i = 0;
+    for (struct arg_item *r = ctx->_requires; r != NULL; r = r->_next, ++i) {
+        arg_arities[i] = r->_required._arity;
+        args[i] = &r->_required;
+        r->_required._slot = (*slots)++;
+    }
+    ctx->_slot = (*slots)++;
+
+    i = 0;
+    for (struct command_item *c = ctx->_commands; c != NULL; c = c->_next, ++i) {
+        names[i] = c->_command._name;
+        name_lens[i] = c->_command._name_len;
+        name_hashes[i] = c->_command._name_hash;
+        commands[i] = &c->_command;
+        if (command_compile(&c->_command, slots) != 0) {
+            return -1;
+        }
+    }
+
+    if (name_index_build(root, &t->_command_index, t->_name_hashes, t->_command_count) != 0) {
+        return -1;
+    }
+
+    ctx->_table = t;
+    return 0;
 }
 
 /*********************************************************************************************************************
  * Print help message
  *********************************************************************************************************************/
 
-static void command_show_help(struct command *ctx) {
-    fprintf(stdout, "\n    Usage: ");
+/*!
+ * Output of the help rendering. Renders into the buffer with snprintf semantics, or directly into the stream if no
+ * buffer is given.
+ */
+struct writer {
+    char *_buf;
+    size_t _size;
+    size_t _len;
+    FILE *_stream;
+};
+
+static void writer_printf(struct writer *ctx, char const *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    int n = 0;
+    if (ctx->_stream != NULL) {
+        n = vfprintf(ctx->_stream, fmt, args);
+    } else {
+        size_t avail = ctx->_len < ctx->_size ? ctx->_size - ctx->_len : 0;
+        n = vsnprintf(avail > 0 ? ctx->_buf + ctx->_len : NULL, avail, fmt, args);
+    }
+    va_end(args);
+    if (n > 0) {
+        ctx->_len += (size_t)n;
+    }
+}
+
+/*!
+ * Prints the names of all parent commands to provide the full commandline
+ */
+static void writer_parents(struct writer *ctx, struct command *cmd) {
+    if (cmd != NULL) {
+        writer_parents(ctx, cmd->_parent);
+        writer_printf(ctx, "%s ", cmd->_name);
+    }
+}
+
+/*!
+ * Position while iterating the flags, args or subcommands of a command. Compiled commands are iterated through their
+ * tables, thus commands declared by parser_define(..) need no registration lists.
+ */
+struct item_iter {
+    size_t _index;
+    void const *_item;
+};
+
+static struct flag const *command_next_flag(struct command const *ctx, struct item_iter *it) {
+    if (ctx->_table != NULL) {
+        return it->_index < ctx->_table->_flag_count ? ctx->_table->_flags[it->_index++] : NULL;
+    }
+    struct flag_item const *item = it->_item == NULL ? ctx->_optionals : ((struct flag_item const *)it->_item)->_next;
+    it->_item = item;
+    return item != NULL ? &item->_optional : NULL;
+}
+
+static struct arg const *command_next_arg(struct command const *ctx, struct item_iter *it) {
+    if (ctx->_table != NULL) {
+        return it->_index < ctx->_table->_arg_count ? ctx->_table->_args[it->_index++] : NULL;
+    }
+    struct arg_item const *item = it->_item == NULL ? ctx->_requires : ((struct arg_item const *)it->_item)->_next;
+    it->_item = item;
+    return item != NULL ? &item->_required : NULL;
+}
+
+static struct command const *command_next_command(struct command const *ctx, struct item_iter *it) {
+    if (ctx->_table != NULL) {
+        return it->_index < ctx->_table->_command_count ? ctx->_table->_commands[it->_index++] : NULL;
+    }
+    struct command_item const *item =
+        it->_item == NULL ? ctx->_commands : ((struct command_item const *)it->_item)->_next;
+    it->_item = item;
+    return item != NULL ? &item->_command : NULL;
+}
 
-    // Print parent arguments to provide full commandline
-    struct command *processed = NULL;
-    while (processed != ctx->_parent) {
-        struct command *c = ctx->_parent;
-        while (c->_parent != processed) {
-            c = c->_parent;
+static void writer_flags(struct writer *ctx, struct command const *cmd, unsigned int required, int width) {
+    struct item_iter it = {0, NULL};
+    for (struct flag const *f = command_next_flag(cmd, &it); f != NULL; f = command_next_flag(cmd, &it)) {
+        if ((f->_flags & SET_REQUIRED) != required) {
+            continue;
+        }
+        // Flags with long name only are aligned with the others
+        char abbr[4] = {'-', f->_short, ',', '\0'};
+        if (f->_short == '\0') {
+            memcpy(abbr, "   ", 4);
+        }
+        if (f->_placeholder == NULL) {
+            writer_printf(ctx, "        %s --%-*s%s\n", abbr, width, f->_long, f->_desc);
+        } else {
+            writer_printf(ctx, "        %s --%s <%s>%-*s%s \n", abbr, f->_long, f->_placeholder,
+                          (int)(width - f->_long_len - strlen(f->_placeholder)) - 3, "", f->_desc);
         }
-        fprintf(stdout, "%s ", c->_name);
-        processed = c;
     }
+}
 
-    fprintf(stdout, "%s ", ctx->_name);
+static void command_write_help(struct command *ctx, struct writer *w) {
+    struct item_iter it = {0, NULL};
+    int has_flags = command_next_flag(ctx, &it) != NULL;
+    it = (struct item_iter){0, NULL};
+    int has_commands = command_next_command(ctx, &it) != NULL;
 
-    if (ctx->_optionals != NULL) {
-        fprintf(stdout, "[OPTIONS] ");
+    writer_printf(w, "\n    Usage: ");
+    writer_parents(w, ctx->_parent);
+    writer_printf(w, "%s ", ctx->_name);
+
+    if (has_flags) {
+        writer_printf(w, "[OPTIONS] ");
     }
-    if (ctx->_commands != NULL) {
-        fprintf(stdout, "[COMMAND] ");
+    if (has_commands) {
+        writer_printf(w, "[COMMAND] ");
     }
 
-    struct arg_item *r = ctx->_requires;
-    while (r != NULL) {
-        fprintf(stdout, "%s ", r->_required._name);
-        if (r->_required.takes() > 1) {
-            fprintf(stdout, "[%s...] ", r->_required._name);
+    int has_args = 0;
+    it = (struct item_iter){0, NULL};
+    for (struct arg const *r = command_next_arg(ctx, &it); r != NULL; r = command_next_arg(ctx, &it)) {
+        writer_printf(w, "%s ", r->_name);
+        if (r->_arity == ARITY_MANY) {
+            writer_printf(w, "[%s...] ", r->_name);
         }
-        r = r->_next;
+        has_args = 1;
     }
-    fprintf(stdout, "\n\n");
+    writer_printf(w, "\n\n");
 
     // Format description, supports manual linebreaks but also adds linebreaks to keep format
     if (ctx->_desc != NULL) {
@@ -504,11 +1523,11 @@ static void command_show_help(struct command *ctx) {
                 ++pos;
             }
             if (*pos == '\0') {
-                fprintf(stdout, "    %s\n", start);
+                writer_printf(w, "    %s\n", start);
                 break;
             } else {
                 if (*pos == '\n' || (pos - start) > 80) {
-                    fprintf(stdout, "    %.*s\n", (int)(pos - start), start);
+                    writer_printf(w, "    %.*s\n", (int)(pos - start), start);
                     start = pos + 1;
                     end = pos + 1;
                 } else {
@@ -516,113 +1535,126 @@ static void command_show_help(struct command *ctx) {
                 }
             }
         }
-        fprintf(stdout, "\n");
+        writer_printf(w, "\n");
     }
 
-    // Display all supported options
-    if (ctx->_optionals != NULL) {
+    // Display all supported options, required and optional flags are counted while determining the width
+    if (has_flags) {
         int width = 4;
-        struct flag_item *opt = ctx->_optionals;
-        while (opt != NULL) {
-            int len = strlen(opt->_optional._long);
-            if (opt->_optional._placeholder != NULL) {
-                len += strlen(opt->_optional._placeholder);
+        int total = 0;
+        int required = 0;
+        it = (struct item_iter){0, NULL};
+        for (struct flag const *f = command_next_flag(ctx, &it); f != NULL; f = command_next_flag(ctx, &it), ++total) {
+            int len = (int)f->_long_len;
+            if (f->_placeholder != NULL) {
+                len += strlen(f->_placeholder);
             }
             if (len + 7 > width) {
                 width = len + 7;
             }
-            opt = opt->_next;
-        }
-
-        int printed = 0;
-        opt = ctx->_optionals;
-        while (opt != NULL) {
-            if ((opt->_optional._flags & SET_REQUIRED) == SET_REQUIRED) {
-                if (printed == 0) {
-                    fprintf(stdout, "    Required flags:\n\n");
-                    printed = 1;
-                }
-                if (opt->_optional._placeholder == NULL) {
-                    fprintf(stdout, "        -%c, --%-*s%s\n", opt->_optional._short, width, opt->_optional._long,
-                            opt->_optional._desc);
-                } else {
-                    fprintf(stdout, "        -%c, --%s <%s>%-*s%s \n", opt->_optional._short, opt->_optional._long,
-                            opt->_optional._placeholder,
-                            (int)(width - strlen(opt->_optional._long) - strlen(opt->_optional._placeholder)) - 3, "",
-                            opt->_optional._desc);
-                }
+            if ((f->_flags & SET_REQUIRED) == SET_REQUIRED) {
+                required += 1;
             }
-            opt = opt->_next;
-        }
-        if (printed == 1) {
-            fprintf(stdout, "\n");
         }
 
-        printed = 0;
-        opt = ctx->_optionals;
-        while (opt != NULL) {
-            if ((opt->_optional._flags & SET_REQUIRED) != SET_REQUIRED) {
-                if (printed == 0) {
-                    fprintf(stdout, "    Optional flags:\n\n");
-                    printed = 1;
-                }
-                if (opt->_optional._placeholder == NULL) {
-                    fprintf(stdout, "        -%c, --%-*s%s\n", opt->_optional._short, width, opt->_optional._long,
-                            opt->_optional._desc);
-                } else {
-                    fprintf(stdout, "        -%c, --%s <%s>%-*s%s \n", opt->_optional._short, opt->_optional._long,
-                            opt->_optional._placeholder,
-                            (int)(width - strlen(opt->_optional._long) - strlen(opt->_optional._placeholder)) - 3, "",
-                            opt->_optional._desc);
-                }
-            }
-            opt = opt->_next;
+        if (required > 0) {
+            writer_printf(w, "    Required flags:\n\n");
+            writer_flags(w, ctx, SET_REQUIRED, width);
+            writer_printf(w, "\n");
         }
-        if (printed == 1) {
-            fprintf(stdout, "\n");
+
+        if (total > required) {
+            writer_printf(w, "    Optional flags:\n\n");
+            writer_flags(w, ctx, SET_NONE, width);
+            writer_printf(w, "\n");
         }
     }
 
     // Display all supported commands
-    if (ctx->_commands != NULL) {
+    if (has_commands) {
         int width = 4;
-        struct command_item *cmd = ctx->_commands;
-        while (cmd != NULL) {
-            int len = strlen(cmd->_command._name);
-            if (len + 4 > width) {
-                width = len + 4;
+        it = (struct item_iter){0, NULL};
+        for (struct command const *c = command_next_command(ctx, &it); c != NULL; c = command_next_command(ctx, &it)) {
+            if ((int)c->_name_len + 4 > width) {
+                width = (int)c->_name_len + 4;
             }
-            cmd = cmd->_next;
         }
 
-        cmd = ctx->_commands;
-        fprintf(stdout, "    Commands:\n\n");
-        while (cmd != NULL) {
-            fprintf(stdout, "        %-*s%s\n", width, cmd->_command._name, cmd->_command._desc);
-            cmd = cmd->_next;
+        writer_printf(w, "    Commands:\n\n");
+        it = (struct item_iter){0, NULL};
+        for (struct command const *c = command_next_command(ctx, &it); c != NULL; c = command_next_command(ctx, &it)) {
+            writer_printf(w, "        %-*s%s\n", width, c->_name, c->_desc);
         }
-        fprintf(stdout, "\n");
+        writer_printf(w, "\n");
     }
 
     // Display all required arguments
-    if (ctx->_requires != NULL) {
+    if (has_args) {
         int width = 4;
-        struct arg_item *req = ctx->_requires;
-        while (req != NULL) {
-            int len = strlen(req->_required._name);
+        it = (struct item_iter){0, NULL};
+        for (struct arg const *r = command_next_arg(ctx, &it); r != NULL; r = command_next_arg(ctx, &it)) {
+            int len = strlen(r->_name);
             if (len + 4 > width) {
                 width = len + 4;
             }
-            req = req->_next;
         }
 
-        req = ctx->_requires;
-        fprintf(stdout, "    Required arguments:\n\n");
-        while (req != NULL) {
-            fprintf(stdout, "        %-*s%s\n", width, req->_required._name, req->_required._desc);
-            req = req->_next;
+        writer_printf(w, "    Required arguments:\n\n");
+        it = (struct item_iter){0, NULL};
+        for (struct arg const *r = command_next_arg(ctx, &it); r != NULL; r = command_next_arg(ctx, &it)) {
+            writer_printf(w, "        %-*s%s\n", width, r->_name, r->_desc);
+        }
+        writer_printf(w, "\n");
+    }
+}
+
+size_t command_help(struct command *ctx, char *buffer, size_t size) {
+    if (ctx == NULL) {
+        return 0;
+    }
+    struct writer w = {buffer, buffer != NULL ? size : 0, 0, NULL};
+    command_write_help(ctx, &w);
+    return w._len;
+}
+
+/*!
+ * Writes all bytes to the file descriptor, retrying on partial writes
+ */
+static void write_all(int fd, char const *buf, size_t len) {
+    while (len > 0) {
+        ssize_t n = write(fd, buf, len);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n <= 0) {
+            return;
+        }
+        buf += n;
+        len -= (size_t)n;
+    }
+}
+
+/*!
+ * Shows the help of the command with a single write. The rendered help is cached in the parser memory, thus
+ * repeated requests only write the cached bytes. Without memory left, the help is printed piece by piece.
+ */
+static void command_show_help(struct command *ctx) {
+    struct command_table *t = ctx->_table;
+    // Declared tables are constant and have no parser memory, their help is printed directly
+    if (t != NULL && t->_help == NULL && ctx->_root->_arena._head != NULL) {
+        size_t len = command_help(ctx, NULL, 0);
+        char *buf = arena_try_alloc(&ctx->_root->_arena, len + 1);
+        if (buf != NULL) {
+            t->_help_len = command_help(ctx, buf, len + 1);
+            t->_help = buf;
         }
-        fprintf(stdout, "\n");
+    }
+
+    if (t != NULL && t->_help != NULL) {
+        fflush(stdout);
+        write_all(STDOUT_FILENO, t->_help, t->_help_len);
+    } else {
+        struct writer w = {NULL, 0, 0, stdout};
+        command_write_help(ctx, &w);
     }
 }
 
@@ -631,74 +1663,316 @@ static void command_show_help(struct command *ctx) {
  *********************************************************************************************************************/
 
 /*!
- * Find the next argument position that is option or command
+ * Find the subcommand with the given name, returns the command count if not found
+ */
+static size_t command_find_command(struct command_table const *t, char const *const arg) {
+    if (t->_command_count == 0) {
+        return 0;
+    }
+    size_t len = 0;
+    uint32_t hash = name_hash(arg, &len);
+    return name_index_find(&t->_command_index, t->_names, t->_name_lens, t->_name_hashes, t->_command_count, arg, len,
+                           hash);
+}
+
+/*!
+ * Arguments of a parse, either an argv array or a NUL separated buffer. Positions are argument indices in both cases.
+ * Arguments within a buffer are located by walkers moving forward from the last known position. Parsing advances the
+ * position and the search for the next option independently, thus each uses its own walker and every argument is
+ * skipped a constant number of times.
+ */
+struct input {
+    char const *const *_argv;
+    char const *_buf;
+    // Index of the first argument of the buffer, 1 if the buffer starts without the program name
+    int _first;
+    int _index[2];
+    char const *_at[2];
+};
+
+enum walker { WALK_POS = 0, WALK_SCAN = 1 };
+
+/*!
+ * Moves the walker of the buffer to the argument at index
+ */
+static char const *input_walk(struct input *ctx, enum walker w, int index) {
+    if (ctx->_index[w] > index) {
+        // Restart from the other walker or the start of the buffer
+        int other = ctx->_index[1 - w] <= index;
+        ctx->_index[w] = other ? ctx->_index[1 - w] : ctx->_first;
+        ctx->_at[w] = other ? ctx->_at[1 - w] : ctx->_buf;
+    }
+    while (ctx->_index[w] < index) {
+        ctx->_at[w] += strlen(ctx->_at[w]) + 1;
+        ctx->_index[w] += 1;
+    }
+    return ctx->_at[w];
+}
+
+static inline char const *input_at(struct input *ctx, enum walker w, int index) {
+    return ctx->_argv != NULL ? ctx->_argv[index] : input_walk(ctx, w, index);
+}
+
+/*!
+ * Appends a run to a list given more than once. The first run stays in the slot as well, thus a list given once
+ * needs no chunk and keeps pointing into argv.
+ */
+static int slot_append(struct parse_result *res, struct slot *ctx, struct list_run const *run) {
+    struct list_chunk *last = ctx->_chunks != NULL ? ctx->_chunks->_last : NULL;
+    if (last == NULL || last->_count == LIST_CHUNK_RUNS) {
+        struct list_chunk *chunk = result_chunk(res);
+        if (chunk == NULL) {
+            return -1;
+        }
+        if (last == NULL) {
+            chunk->_runs[0]._values = ctx->_values;
+            chunk->_runs[0]._count = ctx->_count;
+            chunk->_count = 1;
+            ctx->_chunks = chunk;
+        } else {
+            last->_next = chunk;
+            ctx->_chunks->_last = chunk;
+        }
+        last = chunk;
+    }
+    last->_runs[last->_count++] = *run;
+    ctx->_count += run->_count;
+    return 0;
+}
+
+/*!
+ * Stores the values starting at the given index into the slot, the stored values are described by run. Further
+ * occurrences of a list are appended, a streamed list only keeps the count of its values.
+ */
+static int slot_parse(struct parse_result *res, struct slot *ctx, unsigned char arity, struct input *in, int index,
+                      int argc, struct list_run *run) {
+    if (arity == ARITY_NONE) {
+        ctx->_count += 1;
+        return 0;
+    }
+    if (argc < 1 || (arity == ARITY_ONE && ctx->_count != 0)) {
+        // Fail if a value is given twice
+        return -1;
+    }
+    if (in->_argv != NULL) {
+        run->_values = &in->_argv[index];
+    } else {
+        run->_first = input_at(in, WALK_POS, index);
+    }
+    run->_count = arity == ARITY_ONE ? 1 : (size_t)argc;
+
+    if (ctx->_values == NULL) {
+        // First occurrence, or a streamed list whose previous values were already passed on
+        ctx->_values = run->_values;
+        ctx->_count += run->_count;
+    } else if (slot_append(res, ctx, run) != 0) {
+        return -1;
+    }
+    return (int)run->_count;
+}
+
+/*!
+ * Passes the values just parsed to the callback of a streamed list, only their count is kept in the slot
+ */
+static void slot_stream(struct parse_result const *res, struct slot *ctx, struct list_run const *run,
+                        void (*on_value)(void *, char const *), void *user) {
+    char const *value = NULL;
+    for (size_t k = 0; k < run->_count; ++k) {
+        value = run_value(res, run, k, value);
+        on_value(user, value);
+    }
+    ctx->_values = NULL;
+}
+
+/*!
+ * Classification of a single commandline argument
  */
-static int idx_of_next_opt(struct command *ctx, char const *const *argv, int argc, int start) {
+enum token {
+    TOKEN_VALUE = 0, // Plain value, e.g. `file.txt`
+    TOKEN_DASH,      // Single `-`, treated as value but ends a run of values
+    TOKEN_FLAG,      // Short cluster `-vvv` or long flag `--verbose`
+    TOKEN_SEPARATOR, // `--` forcing continuation with required arguments
+    TOKEN_HELP,      // `-h` or `--help`
+    TOKEN_COMMAND    // Name of a subcommand of the current command
+};
+
+/*!
+ * Classifies the argument, sets the subcommand index for TOKEN_COMMAND
+ */
+static inline enum token token_classify(struct command_table const *t, char const *const arg, size_t *command) {
+    if (arg[0] == '-') {
+        if (arg[1] == '\0') {
+            return TOKEN_DASH;
+        } else if (arg[1] == '-' && arg[2] == '\0') {
+            return TOKEN_SEPARATOR;
+        } else if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0) {
+            return TOKEN_HELP;
+        } else if (convert_digit(arg[1]) >= 0 && t->_short_index[(unsigned char)arg[1]] == 0) {
+            // Negative numbers are values unless the digit is registered as short flag
+            return TOKEN_VALUE;
+        }
+        return TOKEN_FLAG;
+    }
+    *command = command_find_command(t, arg);
+    return *command < t->_command_count ? TOKEN_COMMAND : TOKEN_VALUE;
+}
+
+/*!
+ * Cursor over the commandline arguments of a command. The boundary of the current run of values is only searched
+ * once the parsing position reaches it, thus each argument is classified once and a whole parse is O(argc).
+ */
+struct cursor {
+    int _end;
+    enum token _end_token;
+    size_t _end_command;
+};
+
+/*!
+ * Find the next argument position that is option or command, starting the search at the current boundary
+ */
+static int idx_of_next_opt(struct command_table const *t, struct cursor *ctx, struct input *in, int base, int argc,
+                           int start) {
+    if (ctx->_end >= start) {
+        return ctx->_end;
+    }
     for (int i = start; i < argc; ++i) {
-        if (*argv[i] == '-') {
+        ctx->_end_token = token_classify(t, input_at(in, WALK_SCAN, base + i), &ctx->_end_command);
+        if (ctx->_end_token != TOKEN_VALUE) {
+            ctx->_end = i;
             return i;
-        } else {
-            int arg_len = strlen(argv[i]);
-            struct command_item *c = ctx->_commands;
-            while (c != NULL) {
-                int c_len = strlen(c->_command._name);
-                if (c_len == arg_len && strcmp(argv[i], c->_command._name) == 0) {
-                    return i;
-                }
-                c = c->_next;
+        }
+    }
+    ctx->_end = argc;
+    return argc;
+}
+
+/*!
+ * Returns the classification of the argument at pos, reusing the classification of the boundary if possible
+ */
+static enum token cursor_token(struct command_table const *t, struct cursor *ctx, char const *arg, int pos,
+                               size_t *command) {
+    if (ctx->_end == pos) {
+        *command = ctx->_end_command;
+        return ctx->_end_token;
+    }
+    return token_classify(t, arg, command);
+}
+
+/*!
+ * Converts the values of a typed flag once while parsing, the value of a flag value is kept in its slot
+ */
+static int parse_flag_convert(struct parse_result const *res, struct command_table const *t, size_t i,
+                              struct slot *slot, struct list_run const *run) {
+    if (t->_types[i] == TYPE_STRING) {
+        return 0;
+    }
+    union number scratch;
+    char const *value = NULL;
+    for (size_t k = 0; k < run->_count; ++k) {
+        union number *out = t->_arities[i] == ARITY_ONE ? &slot->_number : &scratch;
+        value = run_value(res, run, k, value);
+        if (convert(t->_types[i], value, out) != 0) {
+            struct flag const *o = t->_flags[i];
+            if (o->_short != '\0') {
+                fprintf(stderr, "Invalid value for option: -%c, --%s <%s>: %s\n", o->_short, o->_long,
+                        o->_placeholder, value);
+            } else {
+                fprintf(stderr, "Invalid value for option: --%s <%s>: %s\n", o->_long, o->_placeholder, value);
             }
+            return -1;
         }
     }
-    return argc;
+    slot->_converted = t->_arities[i] == ARITY_ONE;
+    return 0;
+}
+
+/*!
+ * Finishes the run just stored into the slot of flag i, typed values are converted and streamed values passed on
+ */
+static int parse_flag_values(struct parse_result const *res, struct command_table const *t, size_t i,
+                             struct slot *slot, struct list_run const *run) {
+    if (parse_flag_convert(res, t, i, slot, run) != 0) {
+        return -1;
+    }
+    struct flag const *o = t->_flags[i];
+    if (t->_arities[i] == ARITY_MANY && o->_on_value != NULL) {
+        slot_stream(res, slot, run, o->_on_value, o->_user);
+    }
+    return 0;
+}
+
+/*!
+ * Parses the values of flag i. Returns the number of values taken, -1 if the values are invalid for the flag, and -2
+ * if a value failed to convert.
+ */
+static int parse_flag_item(struct parse_result *res, struct command_table const *t, size_t i, struct input *in,
+                           int index, int argc) {
+    struct slot *slot = result_slot_claim(res, t->_slot_base + i);
+    if (t->_arities[i] == ARITY_MANY && slot->_count != 0 && (t->_settings[i] & SET_REPEATED) == 0) {
+        // Fail if a list is given twice without being repeatable
+        return -1;
+    }
+    struct list_run run = {{NULL}, 0};
+    int n = slot_parse(res, slot, t->_arities[i], in, index, argc, &run);
+    if (n >= 0 && parse_flag_values(res, t, i, slot, &run) != 0) {
+        return -2;
+    }
+    return n;
 }
 
 /*!
  * Parses option, supports flag duplicates using `-v -v -v` or `-vvv`
  */
-static int parse_flag(struct command *ctx, char const *const *argv, int argc, char const *const arg) {
+static int parse_flag(struct parse_result *res, struct command *ctx, struct input *in, int index, int argc,
+                      char const *const arg) {
+    struct command_table const *t = ctx->_table;
     int used = -1;
     int is_short = arg[1] == '-' ? 0 : 1;
 
     if (is_short == 1) {
         // Parse e.g. `-v` and `-vvvv`
-        int len = strlen(arg);
-        for (int i = 1; i < len; ++i) {
-            struct flag_item *opt = ctx->_optionals;
-            while (opt != NULL) {
-                if (opt->_optional._short == arg[i]) {
-                    break;
-                };
-                opt = opt->_next;
+        for (unsigned char const *c = (unsigned char const *)&arg[1]; *c != '\0'; ++c) {
+            if (*c >= 128 || t->_short_index[*c] == 0) {
+                return -1;
             }
 
-            if (opt == NULL) {
+            int n = parse_flag_item(res, t, t->_short_index[*c] - 1, in, index, argc);
+            if (n == -2) {
                 return -1;
             }
-
-            used = (used == -1 ? 0 : used) + opt->_optional.parse(&opt->_optional, argv, argc);
+            used = n < 0 ? -1 : (used == -1 ? 0 : used) + n;
+            if (used == -1) {
+                break;
+            }
         }
     } else {
         // Parse e.g. `--verbose`
-        int len = strlen(&arg[2]);
-        struct flag_item *opt = ctx->_optionals;
-        while (opt != NULL) {
-            int opt_len = strlen(opt->_optional._long);
-            if (len == opt_len && strcmp(opt->_optional._long, &arg[2]) == 0) {
-                break;
-            };
-            opt = opt->_next;
+        size_t len = 0;
+        uint32_t hash = name_hash(&arg[2], &len);
+        size_t i = name_index_find(&t->_long_index, t->_longs, t->_long_lens, t->_long_hashes, t->_flag_count,
+                                   &arg[2], len, hash);
+        if (i == t->_flag_count && ctx->_root->_abbrev == 1) {
+            i = long_prefix_find(t, &arg[2], len);
+            if (i > t->_flag_count) {
+                // Fail without help, the candidates are reported instead
+                long_prefix_report(t, &arg[2], len);
+                return -1;
+            }
         }
 
-        if (opt == NULL) {
+        if (i == t->_flag_count) {
             return -1;
         }
 
-        used = opt->_optional.parse(&opt->_optional, argv, argc);
+        used = parse_flag_item(res, t, i, in, index, argc);
+        if (used == -2) {
+            return -1;
+        }
     }
 
-    // Show help if parsing failed
+    // Request help if parsing failed
     if (used == -1) {
-        command_show_help(ctx);
+        res->_help = ctx;
         return -1;
     }
 
@@ -709,101 +1983,97 @@ static int parse_flag(struct command *ctx, char const *const *argv, int argc, ch
  * Parsing argument for command
  *********************************************************************************************************************/
 
-static int command_check_if_required(struct flag_item *o) {
-    while (o != NULL) {
-        if ((o->_optional._flags & SET_REQUIRED) == SET_REQUIRED) {
-            int takes = o->_optional.takes();
-            int _count = o->_optional._count;
-            if (takes > _count) {
-                if (o->_optional.takes() > 1) {
-                    fprintf(stderr, "Missing option: -%c, --%s <%s...>\n", o->_optional._short, o->_optional._long,
-                            o->_optional._placeholder);
-                } else {
-                    fprintf(stderr, "Missing option: -%c, --%s <%s> \n", o->_optional._short, o->_optional._long,
-                            o->_optional._placeholder);
-                }
-                return -1;
+static int command_check_if_required(struct parse_result *res, struct command *ctx) {
+    struct command_table const *t = ctx->_table;
+    for (size_t i = 0; i < t->_flag_count; ++i) {
+        if ((t->_settings[i] & SET_REQUIRED) == SET_REQUIRED && t->_arities[i] != ARITY_NONE &&
+            result_slot(res, ctx->_root, t->_slot_base + i)->_count == 0) {
+            struct flag const *o = t->_flags[i];
+            if (t->_arities[i] == ARITY_MANY) {
+                fprintf(stderr, "Missing option: -%c, --%s <%s...>\n", o->_short, o->_long, o->_placeholder);
+            } else {
+                fprintf(stderr, "Missing option: -%c, --%s <%s> \n", o->_short, o->_long, o->_placeholder);
             }
+            return -1;
         }
-        o = o->_next;
     }
     return 0;
 }
 
-static int command_parse_args(struct command *ctx, char const *const *argv, int argc) {
+/*!
+ * Parses the arguments of the command, argument i of the command is argument base + i of the input
+ */
+static int command_parse_args(struct parse_result *res, struct command *ctx, struct input *in, int base, int argc) {
+    struct command_table const *t = ctx->_table;
     // Forbid multiple processing of same command
-    if (ctx->_set != 0) {
+    struct slot *set = result_slot_claim(res, ctx->_slot);
+    if (set->_count != 0) {
         return -1;
     }
-    struct arg_item *r = NULL;
-    ctx->_set = 1;
+    set->_count = 1;
+    struct cursor cursor = {0, TOKEN_VALUE, 0};
     int pos = 1;
     while (pos < argc) {
-        int len = strlen(argv[pos]);
-        int end = idx_of_next_opt(ctx, argv, argc, pos + 1);
-
-        if ((len == 6 && strcmp(argv[pos], "--help") == 0) || (len == 2 && strcmp(argv[pos], "-h") == 0)) {
-            // Show help if requested
-            command_show_help(ctx);
+        size_t c = t->_command_count;
+        char const *arg = input_at(in, WALK_POS, base + pos);
+        enum token token = cursor_token(t, &cursor, arg, pos, &c);
+        int end = idx_of_next_opt(t, &cursor, in, base, argc, pos + 1);
+
+        if (token == TOKEN_HELP) {
+            // Request help, it is shown by the caller
+            res->_help = ctx;
             return -1;
-        } else if (len > 1 && *argv[pos] == '-' && (len != 2 || argv[pos][1] != '-')) {
+        } else if (token == TOKEN_FLAG) {
             // Support `--` to force continuation with required arguments
-            int used = parse_flag(ctx, &argv[pos + 1], end - pos - 1, argv[pos]);
+            int used = parse_flag(res, ctx, in, base + pos + 1, end - pos - 1, arg);
             if (used < 0) {
                 return -1;
             }
             pos += used;
-        } else if (pos < argc) {
+        } else {
             // Check if argument is command and if so, parse command
-            struct command_item *c = NULL;
-            if (argv[pos][0] != '-') {
-                c = ctx->_commands;
-                while (c != NULL) {
-                    int c_len = strlen(c->_command._name);
-                    if (len == c_len && strcmp(argv[pos], c->_command._name) == 0) {
-                        int used = command_parse_args(&c->_command, &argv[pos], argc - pos);
-                        if (used == -1) {
-                            return -1;
-                        }
-                        pos += used;
-                        break;
-                    }
-                    c = c->_next;
+            if (token == TOKEN_COMMAND) {
+                int used = command_parse_args(res, t->_commands[c], in, base + pos, argc - pos);
+                if (used == -1) {
+                    return -1;
                 }
-            } else if (len == 2 && argv[pos][1] == '-') {
+                pos += used;
+            } else if (token == TOKEN_SEPARATOR) {
                 // Skip '--'
                 pos += 1;
             }
             // Check for required arguments if arguments remaining and no subcommand was parsed
-            if (pos < argc && c == NULL) {
-                r = ctx->_requires;
-                while (r != NULL) {
+            if (pos < argc && token != TOKEN_COMMAND) {
+                for (size_t i = 0; i < t->_arg_count; ++i) {
                     if (pos >= argc) {
                         return -1;
                     }
-                    int used = r->_required.parse(&r->_required, &argv[pos], argc - pos);
+                    struct slot *slot = result_slot_claim(res, t->_slot_base + t->_flag_count + i);
+                    struct list_run run;
+                    int used = slot_parse(res, slot, t->_arg_arities[i], in, base + pos, argc - pos, &run);
                     if (used == -1) {
                         return -1;
                     }
+                    struct arg const *r = t->_args[i];
+                    if (t->_arg_arities[i] == ARITY_MANY && r->_on_value != NULL) {
+                        slot_stream(res, slot, &run, r->_on_value, r->_user);
+                    }
                     pos += used;
-                    r = r->_next;
                 }
 
-                if (command_check_if_required(ctx->_optionals) != 0) {
+                if (command_check_if_required(res, ctx) != 0) {
                     return -1;
                 } else {
                     return pos;
                 }
             }
-        } else {
-            return -1;
         }
     }
 
-    if (command_check_if_required(ctx->_optionals) != 0) {
+    if (command_check_if_required(res, ctx) != 0) {
         return -1;
     } else {
-        return ctx->_requires == NULL ? pos : -1;
+        return t->_arg_count == 0 ? pos : -1;
     }
 }
 
@@ -811,24 +2081,132 @@ static int command_parse_args(struct command *ctx, char const *const *argv, int
  * Parser
  *********************************************************************************************************************/
 
-struct parser {
-    struct command _internal;
-};
+/*!
+ * Places the parser as first item into the given block, the block becomes the head of the parser's arena
+ */
+static struct parser *parser_place(struct arena_block *block, unsigned int fixed, char const *const name,
+                                   char const *const desc) {
+    struct parser *ctx = arena_block_alloc(block, sizeof(struct parser));
+    if (ctx != NULL) {
+        ctx->_arena._head = block;
+        ctx->_arena._fixed = fixed;
+        ctx->_arena._exhausted = 0;
+        parse_result_place(&ctx->_result, ctx, NULL, 0);
+        command_init(&ctx->_internal, name, desc, ctx, NULL);
+        ctx->_abbrev = 0;
+    }
+    return ctx;
+}
 
+#ifndef ARGPARSE_NO_MALLOC
 struct parser *parser_init(char const *const name, char const *const desc) {
-    struct parser *ctx = malloc(sizeof(struct parser));
-    if (ctx != NULL) {
-        command_init(&ctx->_internal, name, desc, NULL);
+    struct arena_block *block = arena_block_new(sizeof(struct parser));
+    struct parser *ctx = parser_place(block, 0, name, desc);
+    if (ctx == NULL) {
+        free(block);
     }
     return ctx;
 }
+#endif
+
+struct parser *parser_init_static(void *buffer, size_t size, char const *const name, char const *const desc) {
+    return parser_place(arena_block_place(buffer, size), 1, name, desc);
+}
 
 void parser_deinit(struct parser *ctx) {
     if (ctx == NULL) {
         return;
     }
-    command_deinit(&ctx->_internal);
-    free(ctx);
+    // Releases all commands, flags and args including the parser itself
+    struct arena arena = ctx->_arena;
+    arena_deinit(&arena);
+}
+
+int parser_error(struct parser *ctx) {
+    if (ctx == NULL) {
+        return ERR_NO_SPACE;
+    }
+    return ctx->_arena._exhausted == 1 ? ERR_NO_SPACE : ERR_NONE;
+}
+
+void parser_set_abbrev(struct parser *ctx, int enable) {
+    if (ctx != NULL) {
+        ctx->_abbrev = enable != 0 ? 1 : 0;
+    }
+}
+
+int parser_compile(struct parser *ctx) {
+    if (ctx == NULL) {
+        return 1;
+    }
+    if (parser_is_compiled(ctx)) {
+        return 0;
+    }
+
+    size_t count = 0;
+    if (command_compile(&ctx->_internal, &count) != 0) {
+        return 1;
+    }
+
+    struct slot *slots = command_table_array(ctx, count, sizeof(struct slot));
+    if (slots == NULL) {
+        return 1;
+    }
+    parse_result_place(&ctx->_result, ctx, slots, count);
+    return 0;
+}
+
+void parser_reset(struct parser *ctx) {
+    if (ctx != NULL) {
+        parse_result_reset(&ctx->_result);
+    }
+}
+
+size_t parse_result_size(struct parser *ctx) {
+    if (ctx == NULL || !parser_is_compiled(ctx)) {
+        return 0;
+    }
+    // Reserve room to align the result within an arbitrary buffer
+    return _Alignof(max_align_t) - 1 + ARENA_ALIGN(sizeof(struct parse_result)) +
+           ctx->_result._slot_count * sizeof(struct slot);
+}
+
+struct parse_result *parse_result_init(struct parser *ctx, void *buffer, size_t size) {
+    size_t needed = parse_result_size(ctx);
+    if (buffer == NULL || needed == 0 || size < needed) {
+        return NULL;
+    }
+    struct parse_result *result = (struct parse_result *)((char *)buffer + ARENA_ALIGN((uintptr_t)buffer) -
+                                                          (uintptr_t)buffer);
+    struct slot *slots = (struct slot *)((char *)result + ARENA_ALIGN(sizeof(struct parse_result)));
+    memset(slots, 0, ctx->_result._slot_count * sizeof(struct slot));
+    parse_result_place(result, ctx, slots, ctx->_result._slot_count);
+
+    // Storage beyond the slots holds the chunks of repeated lists
+    uintptr_t spare = ARENA_ALIGN((uintptr_t)(slots + ctx->_result._slot_count));
+    if (spare < (uintptr_t)buffer + size) {
+        result->_spare = (char *)buffer + (spare - (uintptr_t)buffer);
+        result->_spare_size = (uintptr_t)buffer + size - spare;
+    }
+    return result;
+}
+
+void parse_result_reset(struct parse_result *result) {
+    if (result == NULL || result->_slots == NULL) {
+        return;
+    }
+    result->_help = NULL;
+    result->_chunks_free = result->_chunks;
+    result->_gen += 1;
+    if (result->_gen == 0) {
+        // Generation wrapped around, clear all slots once to avoid matching stale slots
+        memset(result->_slots, 0, result->_slot_count * sizeof(struct slot));
+        result->_gen = 1;
+    }
+}
+
+struct command *parse_result_help(struct parse_result const *result) {
+    return result != NULL ? result->_help : NULL;
 }
 
 struct command *parser_add_command(struct parser *ctx, char const *const name, char const *const desc) {
@@ -836,31 +2214,513 @@ struct command *parser_add_command(struct parser *ctx, char const *const name, c
 }
 
 struct flag *parser_add_flag(struct parser *ctx, char const flag, char const *const l_flag, char const *const desc) {
-    return command_add_flag_item(&ctx->_internal, flag, l_flag, NULL, desc, SET_NONE, flag_takes, flag_parse);
+    return command_add_flag_item(&ctx->_internal, flag, l_flag, NULL, desc, SET_NONE, ARITY_NONE, TYPE_STRING);
 }
 
 struct flag *parser_add_flag_value(struct parser *ctx, char const flag, char const *const l_flag,
                                    const char *const placeholder, char const *const desc, unsigned int flags) {
-    return command_add_flag_item(&ctx->_internal, flag, l_flag, placeholder, desc, flags, flag_value_takes,
-                                 flag_value_parse);
+    return command_add_flag_item(&ctx->_internal, flag, l_flag, placeholder, desc, flags, ARITY_ONE, TYPE_STRING);
 }
 
 struct flag *parser_add_flag_list(struct parser *ctx, char const flag, char const *const l_flag,
                                   const char *const placeholder, char const *const desc, unsigned int flags) {
-    return command_add_flag_item(&ctx->_internal, flag, l_flag, placeholder, desc, flags, flag_list_takes,
-                                 flag_list_parse);
+    return command_add_flag_item(&ctx->_internal, flag, l_flag, placeholder, desc, flags, ARITY_MANY, TYPE_STRING);
+}
+
+struct flag *parser_add_flag_value_typed(struct parser *ctx, char const flag, char const *const l_flag,
+                                         const char *const placeholder, char const *const desc, unsigned int flags,
+                                         enum types type) {
+    return command_add_flag_value_typed(&ctx->_internal, flag, l_flag, placeholder, desc, flags, type);
+}
+
+struct flag *parser_add_flag_list_typed(struct parser *ctx, char const flag, char const *const l_flag,
+                                        const char *const placeholder, char const *const desc, unsigned int flags,
+                                        enum types type) {
+    return command_add_flag_list_typed(&ctx->_internal, flag, l_flag, placeholder, desc, flags, type);
 }
 
 struct arg *parser_add_arg_value(struct parser *ctx, char const *const name, char const *const desc) {
-    return command_add_arg_item(&ctx->_internal, name, desc, arg_value_takes, arg_value_parse);
+    return command_add_arg_item(&ctx->_internal, name, desc, ARITY_ONE);
 }
 
 struct arg *parser_add_arg_list(struct parser *ctx, char const *const name, char const *const desc) {
-    return command_add_arg_item(&ctx->_internal, name, desc, arg_list_takes, arg_list_parse);
+    return command_add_arg_item(&ctx->_internal, name, desc, ARITY_MANY);
+}
+
+struct flag *parser_add_flag_list_stream(struct parser *ctx, char const flag, char const *const l_flag,
+                                         const char *const placeholder, char const *const desc, unsigned int flags,
+                                         void (*on_value)(void *user, char const *value), void *user) {
+    return command_add_flag_list_stream(&ctx->_internal, flag, l_flag, placeholder, desc, flags, on_value, user);
+}
+
+struct arg *parser_add_arg_list_stream(struct parser *ctx, char const *const name, char const *const desc,
+                                       void (*on_value)(void *user, char const *value), void *user) {
+    return command_add_arg_list_stream(&ctx->_internal, name, desc, on_value, user);
+}
+
+int parser_parse_args_r(struct parser *ctx, struct parse_result *result, char const *const *argv, int argc) {
+    if (ctx == NULL || result == NULL || result->_parser != ctx || result->_slots == NULL) {
+        return 1;
+    }
+    struct input in = {argv, NULL, 0, {0, 0}, {NULL, NULL}};
+    result->_buffer = NULL;
+    return command_parse_args(result, &ctx->_internal, &in, 0, argc) == argc ? 0 : 1;
+}
+
+/*!
+ * Shows the help requested while parsing into the results of the parser, passes the result of the parse through
+ */
+static int parser_parse_done(struct parser *ctx, int res) {
+    if (ctx->_result._help != NULL) {
+        command_show_help(ctx->_result._help);
+    }
+    return res;
 }
 
 int parser_parse_args(struct parser *ctx, char const *const *argv, int argc) {
-    return command_parse_args(&ctx->_internal, argv, argc) == argc ? 0 : 1;
+    if (parser_compile(ctx) != 0) {
+        return 1;
+    }
+    return parser_parse_done(ctx, parser_parse_args_r(ctx, &ctx->_result, argv, argc));
+}
+
+/*!
+ * Parses the NUL separated arguments of the buffer, the first argument of the buffer has the given index
+ */
+static int parser_parse_input(struct parser *ctx, struct parse_result *result, char const *buffer, size_t size,
+                              int first) {
+    if (ctx == NULL || result == NULL || result->_parser != ctx || result->_slots == NULL || buffer == NULL ||
+        (size > 0 && buffer[size - 1] != '\0')) {
+        return 1;
+    }
+
+    // Count the arguments once, memchr(..) is considerably faster than walking the arguments
+    size_t argc = (size_t)first;
+    char const *end = buffer + size;
+    for (char const *it = memchr(buffer, '\0', size); it != NULL; it = memchr(it + 1, '\0', (size_t)(end - it - 1))) {
+        ++argc;
+    }
+    if (argc > INT_MAX) {
+        return 1;
+    }
+
+    struct input in = {NULL, buffer, first, {first, first}, {buffer, buffer}};
+    result->_buffer = buffer;
+    return command_parse_args(result, &ctx->_internal, &in, 0, (int)argc) == (int)argc ? 0 : 1;
+}
+
+int parser_parse_buffer_r(struct parser *ctx, struct parse_result *result, char const *buffer, size_t size) {
+    return parser_parse_input(ctx, result, buffer, size, 0);
+}
+
+int parser_parse_buffer(struct parser *ctx, char const *buffer, size_t size) {
+    if (parser_compile(ctx) != 0) {
+        return 1;
+    }
+    return parser_parse_done(ctx, parser_parse_buffer_r(ctx, &ctx->_result, buffer, size));
+}
+
+int parser_parse_stream_r(struct parser *ctx, struct parse_result *result, int fd, char *buffer, size_t size) {
+    if (buffer == NULL) {
+        return 1;
+    }
+    size_t len = 0;
+    for (;;) {
+        char probe = 0;
+        // A full buffer is only accepted if the stream ends right there
+        ssize_t n = len < size ? read(fd, buffer + len, size - len) : read(fd, &probe, 1);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0) {
+            return 1;
+        } else if (n == 0) {
+            break;
+        } else if (len == size) {
+            errno = ENOBUFS;
+            return 1;
+        }
+        len += (size_t)n;
+    }
+
+    // Terminate the last argument if the stream does not end with NUL
+    if (len > 0 && buffer[len - 1] != '\0') {
+        if (len == size) {
+            errno = ENOBUFS;
+            return 1;
+        }
+        buffer[len++] = '\0';
+    }
+    return parser_parse_input(ctx, result, buffer, len, 1);
+}
+
+int parser_parse_stream(struct parser *ctx, int fd, char *buffer, size_t size) {
+    if (parser_compile(ctx) != 0) {
+        return 1;
+    }
+    return parser_parse_done(ctx, parser_parse_stream_r(ctx, &ctx->_result, fd, buffer, size));
+}
+
+/*********************************************************************************************************************
+ * Line tokenizer
+ *********************************************************************************************************************/
+
+enum line_char { LINE_PLAIN = 0, LINE_END, LINE_BLANK, LINE_QUOTE, LINE_ESCAPE };
+
+/*!
+ * Classes of the characters ending a run of plain characters within a word
+ */
+static unsigned char const line_chars[256] = {
+    ['\0'] = LINE_END,
+    [' '] = LINE_BLANK,
+    ['\t'] = LINE_BLANK,
+    ['\n'] = LINE_BLANK,
+    ['\r'] = LINE_BLANK,
+    ['\''] = LINE_QUOTE,
+    ['"'] = LINE_QUOTE,
+    ['\\'] = LINE_ESCAPE,
+};
+
+/*!
+ * Returns whether the backslash in double quotes escapes the character
+ */
+static int line_quoted_escape(char c) {
+    return c == '"' || c == '\\' || c == '$' || c == '`' || c == '\n';
 }
 
+/*!
+ * Skips the blanks and escaped newlines between two words
+ */
+static char *line_skip(char *in) {
+    while (line_chars[(unsigned char)*in] == LINE_BLANK || (in[0] == '\\' && in[1] == '\n')) {
+        in += in[0] == '\\' ? 2 : 1;
+    }
+    return in;
+}
+
+int line_tokenize(char *line, char const **argv, int size) {
+    if (line == NULL || argv == NULL || size < 1) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    // The unescaped word never outgrows the input, thus out trails in and the words are written in place
+    int argc = 0;
+    char *in = line_skip(line);
+    char *out = in;
+    while (*in != '\0' && *in != '#') {
+        if (argc + 1 >= size) {
+            errno = ENOBUFS;
+            return -1;
+        }
+        argv[argc++] = out;
+
+        unsigned char cls;
+        while ((cls = line_chars[(unsigned char)*in]) != LINE_END && cls != LINE_BLANK) {
+            char c = *in++;
+            if (cls == LINE_PLAIN) {
+                *out++ = c;
+            } else if (c == '\'') {
+                // Single quotes preserve every character up to the closing quote
+                char *end = strchr(in, '\'');
+                if (end == NULL) {
+                    errno = EINVAL;
+                    return -1;
+                }
+                memmove(out, in, (size_t)(end - in));
+                out += end - in;
+                in = end + 1;
+            } else if (c == '"') {
+                for (c = *in++; c != '"'; c = *in++) {
+                    if (c == '\0') {
+                        errno = EINVAL;
+                        return -1;
+                    } else if (c == '\\' && line_quoted_escape(*in)) {
+                        c = *in++;
+                        if (c == '\n') {
+                            continue;
+                        }
+                    }
+                    *out++ = c;
+                }
+            } else if (*in == '\0') {
+                // A trailing backslash continues on the next line
+                errno = EINVAL;
+                return -1;
+            } else if (*in++ != '\n') {
+                *out++ = in[-1];
+            }
+        }
+
+        // Terminate the word, the blank ending it may be overwritten
+        int last = cls == LINE_END;
+        *out++ = '\0';
+        if (last) {
+            break;
+        }
+        in = line_skip(in + 1);
+    }
+    argv[argc] = NULL;
+    return argc;
+}
+
+/*********************************************************************************************************************
+ * Response files
+ *********************************************************************************************************************/
+
+#ifndef ARGPARSE_NO_MALLOC
+
+/*!
+ * Private writable mapping of a response file, followed by at least one zero byte terminating the last argument
+ */
+struct response_map {
+    char *_addr;
+    size_t _size;
+};
+
+struct response {
+    char const **_argv;
+    size_t _argc;
+    size_t _cap;
+    struct response_map *_maps;
+    size_t _map_count;
+    size_t _map_cap;
+};
+
+/*!
+ * Grows the argument array by doubling, thus room for the argument and the terminating NULL is available
+ */
+static int response_reserve(struct response *ctx) {
+    if (ctx->_argc >= INT_MAX - 1) {
+        errno = EOVERFLOW;
+        return -1;
+    }
+    if (ctx->_argc + 2 > ctx->_cap) {
+        size_t cap = ctx->_cap == 0 ? 64 : ctx->_cap * 2;
+        char const **argv = realloc(ctx->_argv, cap * sizeof(char const *));
+        if (argv == NULL) {
+            errno = ENOMEM;
+            return -1;
+        }
+        ctx->_argv = argv;
+        ctx->_cap = cap;
+    }
+    return 0;
+}
+
+static int response_push(struct response *ctx, char const *arg) {
+    if (response_reserve(ctx) != 0) {
+        return -1;
+    }
+    ctx->_argv[ctx->_argc++] = arg;
+    ctx->_argv[ctx->_argc] = NULL;
+    return 0;
+}
+
+/*!
+ * Reads a file without size, e.g. a FIFO or a procfs file, into an anonymous mapping one byte larger than its content
+ */
+static char *response_read(int fd, size_t *size) {
+    char *content = NULL;
+    size_t len = 0;
+    size_t cap = 0;
+    for (;;) {
+        if (len == cap) {
+            cap = cap == 0 ? 4096 : cap * 2;
+            char *grown = realloc(content, cap);
+            if (grown == NULL) {
+                free(content);
+                errno = ENOMEM;
+                return MAP_FAILED;
+            }
+            content = grown;
+        }
+        ssize_t n = read(fd, content + len, cap - len);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0) {
+            int err = errno;
+            free(content);
+            errno = err;
+            return MAP_FAILED;
+        } else if (n == 0) {
+            break;
+        }
+        len += (size_t)n;
+    }
+
+    char *addr = mmap(NULL, len + 1, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (addr != MAP_FAILED) {
+        memcpy(addr, content, len);
+        *size = len;
+    }
+    free(content);
+    return addr;
+}
+
+/*!
+ * Maps the file privately, thus arguments are terminated in place without modifying the file. The file is mapped
+ * over an anonymous mapping one byte larger, which provides the zero byte after the content. Files reporting no size
+ * are read instead.
+ */
+static char *response_map(struct response *ctx, char const *path, size_t *size) {
+    if (ctx->_map_count == ctx->_map_cap) {
+        size_t cap = ctx->_map_cap == 0 ? 4 : ctx->_map_cap * 2;
+        struct response_map *maps = realloc(ctx->_maps, cap * sizeof(struct response_map));
+        if (maps == NULL) {
+            errno = ENOMEM;
+            return NULL;
+        }
+        ctx->_maps = maps;
+        ctx->_map_cap = cap;
+    }
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return NULL;
+    }
+    struct stat st;
+    char *addr = MAP_FAILED;
+    size_t len = 0;
+    if (fstat(fd, &st) == 0) {
+        len = (size_t)st.st_size;
+        addr = len == 0 ? response_read(fd, &len)
+                        : mmap(NULL, len + 1, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+    if (addr != MAP_FAILED && st.st_size > 0 &&
+        mmap(addr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+        int err = errno;
+        munmap(addr, len + 1);
+        errno = err;
+        addr = MAP_FAILED;
+    }
+    int err = errno;
+    close(fd);
+    if (addr == MAP_FAILED) {
+        errno = err;
+        return NULL;
+    }
+
+    ctx->_maps[ctx->_map_count++] = (struct response_map){addr, len + 1};
+    *size = len;
+    return addr;
+}
+
+/*!
+ * Terminates the line in place and removes enclosing quotes, `\"` and `\\` are unescaped within double quotes
+ */
+static char *response_unquote(char *line, size_t len) {
+    if (len < 2 || (line[0] != '"' && line[0] != '\'') || line[len - 1] != line[0]) {
+        line[len] = '\0';
+        return line;
+    }
+    char quote = line[0];
+    char const *it = line + 1;
+    char const *end = line + len - 1;
+    char *out = line;
+    while (it < end) {
+        if (quote == '"' && it[0] == '\\' && it + 1 < end && (it[1] == '"' || it[1] == '\\')) {
+            ++it;
+        }
+        *out++ = *it++;
+    }
+    *out = '\0';
+    return line;
+}
+
+static int response_add(struct response *ctx, char const *arg, int depth);
+
+/*!
+ * Tokenizes the mapped response file in place and adds its arguments
+ */
+static int response_file(struct response *ctx, char const *path, int depth) {
+    size_t size = 0;
+    char *data = response_map(ctx, path, &size);
+    if (data == NULL) {
+        return -1;
+    }
+    char *end = data + size;
+
+    if (memchr(data, '\0', size) != NULL) {
+        // Arguments are already terminated, the mapping is only read
+        for (char *it = data; it < end; it += strlen(it) + 1) {
+            if (response_add(ctx, it, depth) != 0) {
+                return -1;
+            }
+        }
+        return 0;
+    }
+
+    for (char *it = data; it < end;) {
+        char *eol = memchr(it, '\n', (size_t)(end - it));
+        eol = eol != NULL ? eol : end;
+        size_t len = (size_t)(eol - it);
+        if (len > 0 && it[len - 1] == '\r') {
+            --len;
+        }
+        if (len > 0 && response_add(ctx, response_unquote(it, len), depth) != 0) {
+            return -1;
+        }
+        it = eol + 1;
+    }
+    return 0;
+}
+
+/*!
+ * Adds the argument or expands it if it names a response file, depth is the remaining nesting
+ */
+static int response_add(struct response *ctx, char const *arg, int depth) {
+    if (arg[0] != '@' || arg[1] == '\0') {
+        return response_push(ctx, arg);
+    }
+    if (depth == 0) {
+        errno = ELOOP;
+        return -1;
+    }
+    return response_file(ctx, arg + 1, depth - 1);
+}
+
+struct response *response_init(char const *const *argv, int argc, int depth) {
+    if (argv == NULL || argc < 0) {
+        errno = EINVAL;
+        return NULL;
+    }
+    struct response *ctx = calloc(1, sizeof(struct response));
+    if (ctx == NULL) {
+        errno = ENOMEM;
+        return NULL;
+    }
+
+    int res = response_reserve(ctx);
+    if (res == 0) {
+        ctx->_argv[0] = NULL;
+    }
+    for (int i = 0; i < argc && res == 0; ++i) {
+        res = i == 0 || depth <= 0 ? response_push(ctx, argv[i]) : response_add(ctx, argv[i], depth);
+    }
+    if (res != 0) {
+        int err = errno;
+        response_deinit(ctx);
+        errno = err;
+        return NULL;
+    }
+    return ctx;
+}
+
+void response_deinit(struct response *ctx) {
+    if (ctx == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < ctx->_map_count; ++i) {
+        munmap(ctx->_maps[i]._addr, ctx->_maps[i]._size);
+    }
+    free(ctx->_maps);
+    free(ctx->_argv);
+    free(ctx);
+}
+
+char const *const *response_argv(struct response const *ctx) { return ctx != NULL ? ctx->_argv : NULL; }
+
+int response_argc(struct response const *ctx) { return ctx != NULL ? (int)ctx->_argc : 0; }
+#endif
+
 /*********************************************************************************************************************/
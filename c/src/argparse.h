@@ -25,11 +25,29 @@
 #ifndef __ARGPARSE_C__
 #define __ARGPARSE_C__
 
+#include <stddef.h>
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern C {
 #endif
 
-    enum settings { SET_NONE = 0, SET_REQUIRED = 1 };
+    /*!
+     * @brief Settings of flags, combined by bitwise or
+     *
+     * SET_REPEATED lets a list flag be given more than once, e.g. `-I a -I b`, see flag_list_iter(..).
+     */
+    enum settings { SET_NONE = 0, SET_REQUIRED = 1, SET_REPEATED = 2 };
+
+    enum errors { ERR_NONE = 0, ERR_NO_SPACE = 1 };
+
+    /*!
+     * @brief Value types of typed flags, values are converted once while parsing
+     *
+     * Integers are decimal with optional sign, doubles decimal with optional fraction and exponent using '.'
+     * independent of the locale, booleans one of 1/0, true/false, yes/no or on/off ignoring the case.
+     */
+    enum types { TYPE_STRING = 0, TYPE_I64 = 1, TYPE_U64 = 2, TYPE_DOUBLE = 3, TYPE_BOOL = 4 };
 
     /*!
      * @brief Optional parameter type, can be either a simple flag, a optional value, or list of optional values
@@ -79,19 +97,108 @@ extern C {
     /*!
      * @brief Returns the count of provided values
      *
-     * @param list    The optional list structure
-     * @return int    The count of available values
+     * @param list       The optional list structure
+     * @return size_t    The count of available values, 0 if list is NULL
      */
-    int flag_list_count(struct flag * list);
+    size_t flag_list_count(struct flag * list);
 
     /*!
      * @brief Returns the pointer to the array of values
      *
+     * A list registered with SET_REPEATED and given more than once, e.g. `-I a -I b`, gathers the values of all
+     * occurrences. Its values are not contiguous in argv, thus NULL is returned and the values are read with
+     * flag_list_iter(..).
+     *
      * @param list                    The optional list structure
-     * @return char const*  const*    The pointer to the array of values
+     * @return char const*  const*    The pointer to the array of values, NULL if the list was given more than once
      */
     char const *const *flag_list_get(struct flag * list);
 
+    /*!
+     * @brief Position while iterating the values of a list, placed by the caller. All members are private.
+     */
+    struct list_iter {
+        struct parse_result const *_result;
+        struct list_chunk const *_chunk;
+        size_t _run;
+        char const *const *_values;
+        char const *_value;
+        size_t _left;
+    };
+
+    /*!
+     * @brief Starts iterating the values of all occurrences of the list in commandline order
+     *
+     * Works for every parse, including lists given more than once and parses of a buffer. The iterator stays valid
+     * until the results of the parse are reset.
+     *
+     * @param list       The optional list structure
+     * @param it         The iterator to initialize
+     * @return size_t    The number of values, 0 for streamed lists whose values were passed to the callback
+     */
+    size_t flag_list_iter(struct flag * list, struct list_iter * it);
+
+    /*!
+     * @brief Returns the next value of the list
+     *
+     * @param it              The iterator initialized by flag_list_iter(..) or arg_list_iter(..)
+     * @return char const*    The value or NULL if all values were returned
+     */
+    char const *list_iter_next(struct list_iter * it);
+
+    /*!
+     * @brief Returns the value as signed 64 bit integer
+     *
+     * Values of flags registered with TYPE_I64 were converted while parsing, values of other flags are converted on
+     * access. The same applies to the other typed accessors.
+     *
+     * @param value   The optional value structure
+     * @param out     Receives the converted value
+     * @return int    1 if a value is provided, 0 if not, -1 if it is no valid integer of this type
+     */
+    int flag_value_get_i64(struct flag * value, int64_t * out);
+
+    /*!
+     * @brief Returns the value as unsigned 64 bit integer, see flag_value_get_i64(..)
+     */
+    int flag_value_get_u64(struct flag * value, uint64_t * out);
+
+    /*!
+     * @brief Returns the value as double, see flag_value_get_i64(..)
+     */
+    int flag_value_get_double(struct flag * value, double *out);
+
+    /*!
+     * @brief Returns the value as boolean 1 or 0, see flag_value_get_i64(..)
+     */
+    int flag_value_get_bool(struct flag * value, int *out);
+
+    /*!
+     * @brief Converts all values of the list into the caller-provided array
+     *
+     * @param list       The optional list structure
+     * @param values     Array receiving the converted values
+     * @param size       Number of elements of the array
+     * @return size_t    Number of converted values, less than flag_list_count(..) if the array is too small or a
+     *                   value is no valid integer of this type
+     */
+    size_t flag_list_get_i64(struct flag * list, int64_t * values, size_t size);
+
+    /*!
+     * @brief Converts all values of the list into the caller-provided array, see flag_list_get_i64(..)
+     */
+    size_t flag_list_get_u64(struct flag * list, uint64_t * values, size_t size);
+
+    /*!
+     * @brief Converts all values of the list into the caller-provided array, see flag_list_get_i64(..)
+     */
+    size_t flag_list_get_double(struct flag * list, double *values, size_t size);
+
+    /*!
+     * @brief Converts all values of the list into the caller-provided array, see flag_list_get_i64(..)
+     */
+    size_t flag_list_get_bool(struct flag * list, int *values, size_t size);
+
     /*!
      * @brief arg parameter type, can be either arg value, or list of arg values
      */
@@ -108,10 +215,10 @@ extern C {
     /*!
      * @brief Returns the count of provided values
      *
-     * @param list    The arg list structure
-     * @return int    The count of available values
+     * @param list       The arg list structure
+     * @return size_t    The count of available values, 0 if list is NULL
      */
-    int arg_list_count(struct arg * list);
+    size_t arg_list_count(struct arg * list);
 
     /*!
      * @brief Returns the pointer to the array of values
@@ -121,6 +228,11 @@ extern C {
      */
     char const *const *arg_list_get(struct arg * list);
 
+    /*!
+     * @brief Starts iterating the values of the list, see flag_list_iter(..)
+     */
+    size_t arg_list_iter(struct arg * list, struct list_iter * it);
+
     /*!
      * @brief Command type, utilized for parser and subcommands
      */
@@ -134,6 +246,19 @@ extern C {
      */
     int command_is_set(struct command * ctx);
 
+    /*!
+     * @brief Renders the help of the command into the given buffer
+     *
+     * Works like snprintf(..), the output is truncated to the buffer size including the terminating null character.
+     * Passing a NULL buffer only determines the required length.
+     *
+     * @param ctx       The command structure
+     * @param buffer    Caller-provided buffer, may be NULL
+     * @param size      Size of the buffer in bytes
+     * @return size_t   Length of the complete help text without terminating null character
+     */
+    size_t command_help(struct command * ctx, char *buffer, size_t size);
+
     /*!
      * @brief Add new command as subcommand
      *
@@ -185,6 +310,38 @@ extern C {
     struct flag *command_add_flag_list(struct command * ctx, char const flag, char const *const l_flag,
                                        char const *const placeholder, char const *const desc, unsigned int flags);
 
+    /*!
+     * @brief Add new optional value of the given type to command, parsing fails if the value doesn't convert
+     *
+     * @param ctx                 The parent command structure
+     * @param flag                The short version of the value flag
+     * @param l_flag              The long version of the value flag
+     * @param placeholder         Text placeholder for value.
+     * @param desc                Description of the value flag
+     * @param flags                1 if flag is arg, else 0
+     * @param type                Type of the value
+     * @return struct flag*   Reference to the newly added optional value
+     */
+    struct flag *command_add_flag_value_typed(struct command * ctx, char const flag, char const *const l_flag,
+                                              char const *const placeholder, char const *const desc,
+                                              unsigned int flags, enum types type);
+
+    /*!
+     * @brief Add new optional list of values of the given type to command, parsing fails if a value doesn't convert
+     *
+     * @param ctx                 The parent command structure
+     * @param flag                The short version of the list of values flag
+     * @param l_flag              The long version of the list of values flag
+     * @param placeholder         Text placeholder for value.
+     * @param desc                Description of the list of values flag
+     * @param flags                1 if flag is arg, else 0
+     * @param type                Type of the values
+     * @return struct flag*   Reference to the newly added optional list of values
+     */
+    struct flag *command_add_flag_list_typed(struct command * ctx, char const flag, char const *const l_flag,
+                                             char const *const placeholder, char const *const desc,
+                                             unsigned int flags, enum types type);
+
     /*!
      * @brief Add new arg value to command
      *
@@ -207,27 +364,93 @@ extern C {
      */
     struct arg *command_add_arg_list(struct command * ctx, char const *const name, char const *const desc);
 
+    /*!
+     * @brief Add new optional list of values to command, each value is passed to the callback while parsing
+     *
+     * The values are not kept, flag_list_count(..) reports their number and flag_list_get(..) returns NULL. Once the end
+     * of the list is known, the callback receives all of its values in commandline order, even if the parse fails later
+     * on.
+     *
+     * @param ctx                 The parent command structure
+     * @param flag                The short version of the list of values flag
+     * @param l_flag              The long version of the list of values flag
+     * @param placeholder         Text placeholder for value.
+     * @param desc                Description of the list of values flag
+     * @param flags                1 if flag is arg, else 0
+     * @param on_value            Callback receiving user and each value, pointing into argv
+     * @param user                Passed to the callback unchanged
+     * @return struct flag*   Reference to the newly added optional list of values, NULL if on_value is NULL
+     */
+    struct flag *command_add_flag_list_stream(struct command * ctx, char const flag, char const *const l_flag,
+                                              char const *const placeholder, char const *const desc,
+                                              unsigned int flags, void (*on_value)(void *user, char const *value),
+                                              void *user);
+
+    /*!
+     * @brief Add new arg list of values to command, each value is passed to the callback while parsing
+     *
+     * See command_add_flag_list_stream(..), arg_list_count(..) reports the number of values.
+     *
+     * @param ctx                 The parent command structure
+     * @param name                Name of the arg list
+     * @param desc                Description of the arg list
+     * @param on_value            Callback receiving user and each value, pointing into argv
+     * @param user                Passed to the callback unchanged
+     * @return struct arg*   Reference to the newly added arg list of values, NULL if on_value is NULL
+     */
+    struct arg *command_add_arg_list_stream(struct command * ctx, char const *const name, char const *const desc,
+                                            void (*on_value)(void *user, char const *value), void *user);
+
     /*!
      * @brief Parser structure holding all optional/arg values and commands
      */
     struct parser;
 
+#ifndef ARGPARSE_NO_MALLOC
     /*!
      * @brief Initializes a new parser structure, call parser_deinit(..) to free it
      *
+     * All commands, flags and args added to the parser are placed into a few contiguous blocks owned by the parser.
+     *
      * @param name               Name of the application (most likely argv[0])
      * @param desc               Description of the application, custom linebreaks supported
      * @return struct parser*    Reference to the newly allocated parser structure
      */
     struct parser *parser_init(char const *const name, char const *const desc);
+#endif
+
+    /*!
+     * @brief Initializes a new parser structure inside of the given buffer without any heap allocation
+     *
+     * The parser and all commands, flags and args added later on are placed into the buffer. If the buffer is
+     * exhausted, the add functions return NULL and parser_error(..) reports ERR_NO_SPACE. The buffer has to
+     * outlive the parser, parser_deinit(..) never frees it.
+     *
+     * @param buffer             Caller-provided storage
+     * @param size               Size of the storage in bytes
+     * @param name               Name of the application (most likely argv[0])
+     * @param desc               Description of the application, custom linebreaks supported
+     * @return struct parser*    Reference to the parser structure or NULL if the buffer is too small
+     */
+    struct parser *parser_init_static(void *buffer, size_t size, char const *const name, char const *const desc);
 
     /*!
      * @brief Deinitializes the parser structure, freeing all optional/arg parameters and subcommands
      *
+     * Releases the memory blocks of the parser at once, all references into the parser become invalid.
+     *
      * @param ctx    The parser context
      */
     void parser_deinit(struct parser * ctx);
 
+    /*!
+     * @brief Returns whether the parser ran out of memory while adding commands, flags or args
+     *
+     * @param ctx    The parser context
+     * @return int   ERR_NONE if all items were added, ERR_NO_SPACE if at least one allocation failed
+     */
+    int parser_error(struct parser * ctx);
+
     /*!
      * @brief Adds a new command to the parser
      *
@@ -278,6 +501,20 @@ extern C {
     struct flag *parser_add_flag_list(struct parser * ctx, char const flag, char const *const l_flag,
                                       const char *const placeholder, char const *const desc, unsigned int flags);
 
+    /*!
+     * @brief Adds a new optional value of the given type to the parser, see command_add_flag_value_typed(..)
+     */
+    struct flag *parser_add_flag_value_typed(struct parser * ctx, char const flag, char const *const l_flag,
+                                             const char *const placeholder, char const *const desc,
+                                             unsigned int flags, enum types type);
+
+    /*!
+     * @brief Adds a new optional value list of the given type to the parser, see command_add_flag_list_typed(..)
+     */
+    struct flag *parser_add_flag_list_typed(struct parser * ctx, char const flag, char const *const l_flag,
+                                            const char *const placeholder, char const *const desc,
+                                            unsigned int flags, enum types type);
+
     /*!
      * @brief Adds a new arg value to the parser
      *
@@ -298,21 +535,380 @@ extern C {
      */
     struct arg *parser_add_arg_list(struct parser * ctx, char const *const name, char const *const desc);
 
+    /*!
+     * @brief Adds a new optional value list streamed to a callback to the parser, see command_add_flag_list_stream(..)
+     */
+    struct flag *parser_add_flag_list_stream(struct parser * ctx, char const flag, char const *const l_flag,
+                                             const char *const placeholder, char const *const desc,
+                                             unsigned int flags, void (*on_value)(void *user, char const *value),
+                                             void *user);
+
+    /*!
+     * @brief Adds a new arg value list streamed to a callback to the parser, see command_add_arg_list_stream(..)
+     */
+    struct arg *parser_add_arg_list_stream(struct parser * ctx, char const *const name, char const *const desc,
+                                           void (*on_value)(void *user, char const *value), void *user);
+
+    /*!
+     * @brief Enables or disables unique-prefix abbreviations of long flags, disabled by default
+     *
+     * If enabled, a long flag not registered under the given name, e.g. `--verb`, matches the long flag starting with
+     * it, e.g. `--verbose`. An exact name always takes precedence. A prefix of several long names fails the parse and
+     * reports all candidates. Enable it before compiling to build the sorted name order of each command, which
+     * resolves a prefix in O(log n). Otherwise, e.g. for parsers declared by parser_define(..), the names are
+     * scanned linearly.
+     *
+     * @param ctx       The parser context
+     * @param enable    1 to enable, 0 to disable abbreviations
+     */
+    void parser_set_abbrev(struct parser * ctx, int enable);
+
+    /*!
+     * @brief Compiles the registered commands, flags and args into flat lookup tables
+     *
+     * After compilation no further commands, flags or args can be added, the add functions return NULL. Parsing
+     * compiles the parser implicitly if not done beforehand.
+     *
+     * @param ctx    The parser context
+     * @return int   0 on success, 1 on failure (see parser_error(..))
+     */
+    int parser_compile(struct parser * ctx);
+
+    /*!
+     * @brief Invalidates the results of the previous parse, thus the parser can parse another commandline
+     *
+     * Resetting is O(1) independent of the number of commands, flags and args. All values returned by the accessors
+     * for the previous parse become invalid. Only affects the results of parser_parse_args(..), see
+     * parse_result_reset(..) for results of parser_parse_args_r(..).
+     *
+     * @param ctx    The parser context
+     */
+    void parser_reset(struct parser * ctx);
+
     /*!
      * @brief Parsing of the given arguments
      *
      * @param ctx    The context containing the supported argument definitions
      * @param argv   The array of commandline arguments
      * @param argc   Number of commandline arguments provided
-     * @return int   1 on success, 0 on failure.
+     * @return int   0 on success, 1 on failure. Call parser_reset(..) before parsing another commandline.
      */
     int parser_parse_args(struct parser * ctx, char const *const *argv, int argc);
 
+    /*!
+     * @brief Results of a single parse, separated from the parser to parse concurrently with the same parser
+     *
+     * The compiled parser is immutable and can be shared between threads, each thread parses into its own result.
+     */
+    struct parse_result;
+
+    /*!
+     * @brief Returns the size of the storage required by parse_result_init(..)
+     *
+     * @param ctx       The compiled parser context
+     * @return size_t   Required size in bytes, 0 if the parser is not compiled
+     */
+    size_t parse_result_size(struct parser * ctx);
+
+    /*!
+     * @brief Initializes an empty parse result for the parser inside of the given buffer
+     *
+     * The buffer is owned by the caller, e.g. placed on the stack or in an arena of the calling thread, and has to
+     * outlive the result. The parser has to be compiled beforehand using parser_compile(..). Storage beyond
+     * parse_result_size(..) holds the occurrences of lists given more than once, without it such lists fail to parse.
+     *
+     * @param ctx                      The compiled parser context
+     * @param buffer                   Caller-provided storage
+     * @param size                     Size of the storage in bytes, at least parse_result_size(..)
+     * @return struct parse_result*    Reference to the result or NULL if the buffer is too small
+     */
+    struct parse_result *parse_result_init(struct parser * ctx, void *buffer, size_t size);
+
+    /*!
+     * @brief Invalidates the values of the previous parse in O(1), thus the result can be reused
+     *
+     * @param result    The parse result
+     */
+    void parse_result_reset(struct parse_result * result);
+
+    /*!
+     * @brief Returns the command whose help was requested or whose flags failed to parse
+     *
+     * parser_parse_args_r(..) never prints, pass the command to command_help(..) to render the help.
+     *
+     * @param result              The parse result
+     * @return struct command*    The command or NULL if no help is requested
+     */
+    struct command *parse_result_help(struct parse_result const *result);
+
+    /*!
+     * @brief Parsing of the given arguments into the given result, safe to call concurrently on a compiled parser
+     *
+     * @param ctx      The compiled parser context
+     * @param result   The result to fill, created by parse_result_init(..) for the same parser
+     * @param argv     The array of commandline arguments
+     * @param argc     Number of commandline arguments provided
+     * @return int     0 on success, 1 on failure. Call parse_result_reset(..) before parsing another commandline.
+     */
+    int parser_parse_args_r(struct parser * ctx, struct parse_result * result, char const *const *argv, int argc);
+
+    /*!
+     * @brief Parsing of the NUL separated arguments of a contiguous buffer, e.g. the content of /proc/<pid>/cmdline
+     *
+     * No argv array is built, values are kept as pointers into the buffer and the buffer has to outlive the results.
+     * Values are read by the usual accessors or as offsets into the buffer by flag_value_offset(..) and friends.
+     * flag_list_get(..) and arg_list_get(..) return NULL for such parses, the values of a list follow each other in
+     * the buffer starting at flag_list_offset(..) resp. arg_list_offset(..).
+     *
+     * @param ctx      The context containing the supported argument definitions
+     * @param buffer   The arguments including the program name, each terminated by a NUL byte
+     * @param size     Size of the buffer in bytes, the last byte has to be NUL
+     * @return int     0 on success, 1 on failure. Call parser_reset(..) before parsing another commandline.
+     */
+    int parser_parse_buffer(struct parser * ctx, char const *buffer, size_t size);
+
+    /*!
+     * @brief See parser_parse_buffer(..), parses into the given result like parser_parse_args_r(..)
+     */
+    int parser_parse_buffer_r(struct parser * ctx, struct parse_result * result, char const *buffer, size_t size);
+
+    /*!
+     * @brief Parsing of the NUL separated arguments read from a stream until its end, e.g. the input of xargs -0
+     *
+     * The stream contains the arguments only, no program name. They are read into the caller-provided buffer, which
+     * has to outlive the results, see parser_parse_buffer(..). A missing NUL after the last argument is added.
+     *
+     * @param ctx      The context containing the supported argument definitions
+     * @param fd       The file descriptor to read from
+     * @param buffer   Caller-provided storage receiving the stream
+     * @param size     Size of the storage in bytes
+     * @return int     0 on success, 1 on failure. errno is ENOBUFS if the stream does not fit into the buffer.
+     */
+    int parser_parse_stream(struct parser * ctx, int fd, char *buffer, size_t size);
+
+    /*!
+     * @brief See parser_parse_stream(..), parses into the given result like parser_parse_args_r(..)
+     */
+    int parser_parse_stream_r(struct parser * ctx, struct parse_result * result, int fd, char *buffer, size_t size);
+
+    /*!
+     * @brief Returns the offset of the value into the buffer of parser_parse_buffer(..) or parser_parse_stream(..)
+     *
+     * @param value     The flag value structure
+     * @param offset    Receives the offset of the first character of the value
+     * @return int      1 if the offset is written, 0 if no value was parsed, -1 if the last parse used argv
+     */
+    int flag_value_offset(struct flag * value, size_t * offset);
+
+    /*!
+     * @brief Returns the offset of the first value, see flag_value_offset(..)
+     */
+    int flag_list_offset(struct flag * list, size_t * offset);
+
+    /*!
+     * @brief Returns the offset of the value, see flag_value_offset(..)
+     */
+    int arg_value_offset(struct arg * value, size_t * offset);
+
+    /*!
+     * @brief Returns the offset of the first value, see flag_value_offset(..)
+     */
+    int arg_list_offset(struct arg * list, size_t * offset);
+
+    /*!
+     * @brief See flag_value_offset(..), reads from the given result
+     */
+    int flag_value_offset_r(struct parse_result const *result, struct flag * value, size_t * offset);
+
+    /*!
+     * @brief See flag_list_offset(..), reads from the given result
+     */
+    int flag_list_offset_r(struct parse_result const *result, struct flag * list, size_t * offset);
+
+    /*!
+     * @brief See arg_value_offset(..), reads from the given result
+     */
+    int arg_value_offset_r(struct parse_result const *result, struct arg * value, size_t * offset);
+
+    /*!
+     * @brief See arg_list_offset(..), reads from the given result
+     */
+    int arg_list_offset_r(struct parse_result const *result, struct arg * list, size_t * offset);
+
+    /*!
+     * @brief Splits a line into words following the quoting rules of the POSIX shell, e.g. for an interactive console
+     *
+     * Words are separated by blanks, a word starting with # comments out the rest of the line. Single quotes keep
+     * every character, within double quotes a backslash only escapes $, `, ", \ and newline, outside of quotes it
+     * escapes any character. An escaped newline continues the word. No expansions are performed. The words are
+     * unescaped in place, thus the line is modified even on failure and has to outlive the words. Pass argv + 1 to
+     * keep argv[0] for the program name expected by parser_parse_args(..).
+     *
+     * @param line     The NUL terminated line, carriage returns count as blanks
+     * @param argv     Receives the words followed by NULL
+     * @param size     Number of elements of argv
+     * @return int     Number of words or -1 on failure. errno is EINVAL if a quote is not closed or the line ends with
+     *                 a backslash, e.g. to read a continuation line, and ENOBUFS if argv is too small.
+     */
+    int line_tokenize(char *line, char const **argv, int size);
+
+#ifndef ARGPARSE_NO_MALLOC
+    /*!
+     * @brief Commandline with all @file arguments replaced by the arguments stored in the response file
+     */
+    struct response;
+
+    /*!
+     * @brief Expands response files, call response_deinit(..) to release the expanded commandline
+     *
+     * Every argument after argv[0] starting with '@' names a response file, which is memory mapped and tokenized in
+     * place. Files containing a NUL byte hold NUL separated arguments, e.g. from `find -print0`, any other file holds
+     * one argument per line with empty lines skipped. A line enclosed in single or double quotes is taken without the
+     * quotes, within double quotes `\"` and `\\` are unescaped. Arguments of response files may name further response
+     * files up to the given depth.
+     *
+     * The expanded arguments point into the mappings, thus the response has to outlive all parse results filled from
+     * it. Only the array of pointers is allocated, the arguments themselves are never copied.
+     *
+     * @param argv                 The array of commandline arguments
+     * @param argc                 Number of commandline arguments provided
+     * @param depth                Maximum nesting of response files, 0 disables the expansion
+     * @return struct response*    The expanded commandline, NULL on failure with errno set (ELOOP if too deeply nested)
+     */
+    struct response *response_init(char const *const *argv, int argc, int depth);
+
+    /*!
+     * @brief Releases the expanded commandline and unmaps all response files
+     */
+    void response_deinit(struct response * ctx);
+
+    /*!
+     * @brief Returns the expanded array of arguments, terminated by NULL
+     */
+    char const *const *response_argv(struct response const *ctx);
+
+    /*!
+     * @brief Returns the number of expanded arguments
+     */
+    int response_argc(struct response const *ctx);
+#endif
+
+    /*!
+     * @brief See flag_count(..), reads from the given result
+     */
+    int flag_count_r(struct parse_result const *result, struct flag * flag);
+
+    /*!
+     * @brief See flag_set(..), reads from the given result
+     */
+    int flag_set_r(struct parse_result const *result, struct flag * flag);
+
+    /*!
+     * @brief See flag_value_exists(..), reads from the given result
+     */
+    int flag_value_exists_r(struct parse_result const *result, struct flag * value);
+
+    /*!
+     * @brief See flag_value_get(..), reads from the given result
+     */
+    char const *flag_value_get_r(struct parse_result const *result, struct flag * value);
+
+    /*!
+     * @brief See flag_list_exists(..), reads from the given result
+     */
+    int flag_list_exists_r(struct parse_result const *result, struct flag * list);
+
+    /*!
+     * @brief See flag_list_count(..), reads from the given result
+     */
+    size_t flag_list_count_r(struct parse_result const *result, struct flag * list);
+
+    /*!
+     * @brief See flag_list_get(..), reads from the given result
+     */
+    char const *const *flag_list_get_r(struct parse_result const *result, struct flag * list);
+
+    /*!
+     * @brief See arg_value_get(..), reads from the given result
+     */
+    char const *arg_value_get_r(struct parse_result const *result, struct arg * value);
+
+    /*!
+     * @brief See arg_list_count(..), reads from the given result
+     */
+    size_t arg_list_count_r(struct parse_result const *result, struct arg * list);
+
+    /*!
+     * @brief See arg_list_get(..), reads from the given result
+     */
+    char const *const *arg_list_get_r(struct parse_result const *result, struct arg * list);
+
+    /*!
+     * @brief See flag_list_iter(..), reads from the given result
+     */
+    size_t flag_list_iter_r(struct parse_result const *result, struct flag * list, struct list_iter * it);
+
+    /*!
+     * @brief See arg_list_iter(..), reads from the given result
+     */
+    size_t arg_list_iter_r(struct parse_result const *result, struct arg * list, struct list_iter * it);
+
+    /*!
+     * @brief See command_is_set(..), reads from the given result
+     */
+    int command_is_set_r(struct parse_result const *result, struct command * ctx);
+
+    /*!
+     * @brief See flag_value_get_i64(..), reads from the given result
+     */
+    int flag_value_get_i64_r(struct parse_result const *result, struct flag * value, int64_t * out);
+
+    /*!
+     * @brief See flag_value_get_u64(..), reads from the given result
+     */
+    int flag_value_get_u64_r(struct parse_result const *result, struct flag * value, uint64_t * out);
+
+    /*!
+     * @brief See flag_value_get_double(..), reads from the given result
+     */
+    int flag_value_get_double_r(struct parse_result const *result, struct flag * value, double *out);
+
+    /*!
+     * @brief See flag_value_get_bool(..), reads from the given result
+     */
+    int flag_value_get_bool_r(struct parse_result const *result, struct flag * value, int *out);
+
+    /*!
+     * @brief See flag_list_get_i64(..), reads from the given result
+     */
+    size_t flag_list_get_i64_r(struct parse_result const *result, struct flag * list, int64_t * values, size_t size);
+
+    /*!
+     * @brief See flag_list_get_u64(..), reads from the given result
+     */
+    size_t flag_list_get_u64_r(struct parse_result const *result, struct flag * list, uint64_t * values, size_t size);
+
+    /*!
+     * @brief See flag_list_get_double(..), reads from the given result
+     */
+    size_t flag_list_get_double_r(struct parse_result const *result, struct flag * list, double *values, size_t size);
+
+    /*!
+     * @brief See flag_list_get_bool(..), reads from the given result
+     */
+    size_t flag_list_get_bool_r(struct parse_result const *result, struct flag * list, int *values, size_t size);
+
 /*!
  * @brief See parser_init(..)
  */
 #define parser_new(var, name, desc) struct parser *var = parser_init(name, desc)
 
+/*!
+ * @brief See parser_init_static(..)
+ */
+#define parser_new_static(var, buffer, name, desc)                                                                     \
+    struct parser *var = parser_init_static(buffer, sizeof(buffer), name, desc)
+
 /*!
  * @brief See parser_add_flag(..)
  */
@@ -330,6 +926,25 @@ extern C {
 #define add_flag_list(parser, var, s_flag, l_flag, placeholder, desc, flags)                                           \
     struct flag *var = parser_add_flag_list(parser, s_flag, l_flag, placeholder, desc, flags)
 
+/*!
+ * @brief See parser_add_flag_value_typed(..)
+ */
+#define add_flag_value_typed(parser, var, s_flag, l_flag, placeholder, desc, flags, type)                              \
+    struct flag *var = parser_add_flag_value_typed(parser, s_flag, l_flag, placeholder, desc, flags, type)
+
+/*!
+ * @brief See parser_add_flag_list_typed(..)
+ */
+#define add_flag_list_typed(parser, var, s_flag, l_flag, placeholder, desc, flags, type)                               \
+    struct flag *var = parser_add_flag_list_typed(parser, s_flag, l_flag, placeholder, desc, flags, type)
+
+/*!
+ * @brief See parser_add_flag_list_stream(..)
+ */
+#define add_flag_list_stream(parser, var, s_flag, l_flag, placeholder, desc, flags, on_value, user)                    \
+    struct flag *var =                                                                                                 \
+        parser_add_flag_list_stream(parser, s_flag, l_flag, placeholder, desc, flags, on_value, user)
+
 /*!
  * @brief See parser_add_arg_value(..)
  */
@@ -340,6 +955,12 @@ extern C {
  */
 #define add_arg_list(parser, var, name, desc) struct arg *var = parser_add_arg_list(parser, name, desc)
 
+/*!
+ * @brief See parser_add_arg_list_stream(..)
+ */
+#define add_arg_list_stream(parser, var, name, desc, on_value, user)                                                   \
+    struct arg *var = parser_add_arg_list_stream(parser, name, desc, on_value, user)
+
 /*!
  * @brief See parser_add_command(..)
  */
@@ -363,6 +984,24 @@ extern C {
 #define cmd_add_flag_list(cmd, var, s_flag, l_flag, placeholder, desc, flags)                                          \
     struct flag *var = command_add_flag_list(cmd, s_flag, l_flag, placeholder, desc, flags)
 
+/*!
+ * @brief See command_add_flag_value_typed(..)
+ */
+#define cmd_add_flag_value_typed(cmd, var, s_flag, l_flag, placeholder, desc, flags, type)                             \
+    struct flag *var = command_add_flag_value_typed(cmd, s_flag, l_flag, placeholder, desc, flags, type)
+
+/*!
+ * @brief See command_add_flag_list_typed(..)
+ */
+#define cmd_add_flag_list_typed(cmd, var, s_flag, l_flag, placeholder, desc, flags, type)                              \
+    struct flag *var = command_add_flag_list_typed(cmd, s_flag, l_flag, placeholder, desc, flags, type)
+
+/*!
+ * @brief See command_add_flag_list_stream(..)
+ */
+#define cmd_add_flag_list_stream(cmd, var, s_flag, l_flag, placeholder, desc, flags, on_value, user)                   \
+    struct flag *var = command_add_flag_list_stream(cmd, s_flag, l_flag, placeholder, desc, flags, on_value, user)
+
 /*!
  * @brief See command_add_arg_value(..)
  */
@@ -373,11 +1012,304 @@ extern C {
  */
 #define cmd_add_arg_list(cmd, var, name, desc) struct arg *var = command_add_arg_list(cmd, name, desc)
 
+/*!
+ * @brief See command_add_arg_list_stream(..)
+ */
+#define cmd_add_arg_list_stream(cmd, var, name, desc, on_value, user)                                                  \
+    struct arg *var = command_add_arg_list_stream(cmd, name, desc, on_value, user)
+
 /*!
  * @brief See command_add_command(..)
  */
 #define cmd_add_subcommand(cmd, var, name, desc) struct command *var = command_add_subcommand(cmd, name, desc)
 
+/*!
+ * @brief Declares a parser as constant data, no memory is allocated and no tables are compiled at runtime
+ *
+ * The items of a command are listed by a macro taking the item macro X and its context P, e.g.
+ *
+ *   #define TOOL_ITEMS(X, P)                                                   \
+ *       X(P, FLAG, tool_verbose, 'v', "verbose", "Verbose output.")            \
+ *       X(P, COMMAND, tool_run, "run", "Runs the tool.")
+ *
+ * with the following kinds of items, the ident names the handle of the item:
+ *
+ *   X(P, FLAG, ident, s_flag, l_flag, desc)
+ *   X(P, VALUE, ident, s_flag, l_flag, placeholder, desc, flags)
+ *   X(P, LIST, ident, s_flag, l_flag, placeholder, desc, flags)
+ *   X(P, VALUE_TYPED, ident, s_flag, l_flag, placeholder, desc, flags, type)
+ *   X(P, LIST_TYPED, ident, s_flag, l_flag, placeholder, desc, flags, type)
+ *   X(P, ARG, ident, name, desc)
+ *   X(P, ARGS, ident, name, desc)
+ *   X(P, COMMAND, ident, name, desc)
+ *
+ * Every subcommand is listed with its items by the commands macro, use parser_no_commands if there are none:
+ *
+ *   #define TOOL_COMMANDS(X, P) X(P, tool_run, TOOL_RUN_ITEMS)
+ *
+ * Names, long flags and the parser name have to be string literals. The declaration defines the parser handle var
+ * and the handles of all items at file scope, only the parse results are mutable. Requires argparse_internal.h for
+ * the layout of the tables, names are found by length and comparison instead of a hash index.
+ *
+ * @param var Handle of the parser
+ * @param name Name of the parser
+ * @param desc Description of the parser
+ * @param items Macro listing the items of the parser
+ * @param commands Macro listing the subcommands and their items
+ */
+#define parser_define(var, name, desc, items, commands)                                                                \
+    static struct parser var##_argparse_storage;                                                                       \
+    static struct command_table const var##_argparse_table;                                                            \
+    commands(ARGPARSE_DEF_DECLARE, var)                                                                                \
+    ARGPARSE_DEF_COUNTS(var, var, items)                                                                               \
+    commands(ARGPARSE_DEF_COUNTS, var)                                                                                 \
+    enum {                                                                                                             \
+        var##_argparse_base = 0,                                                                                       \
+        var##_argparse_last = var##_argparse_nflags + var##_argparse_nargs,                                            \
+        commands(ARGPARSE_DEF_BASE, var) var##_argparse_slot_count                                                     \
+    };                                                                                                                 \
+    ARGPARSE_DEF_TABLE(var, var, items)                                                                                \
+    commands(ARGPARSE_DEF_TABLE, var)                                                                                  \
+    static struct slot var##_argparse_slots[var##_argparse_slot_count];                                                \
+    static struct list_chunk var##_argparse_chunks[ARGPARSE_STATIC_CHUNKS];                                            \
+    static struct parser var##_argparse_storage = {                                                                    \
+        ._internal = {._name = name,                                                                                   \
+                      ._desc = desc,                                                                                   \
+                      ._name_len = sizeof(name) - 1,                                                                   \
+                      ._slot = var##_argparse_self,                                                                    \
+                      ._root = &var##_argparse_storage,                                                                \
+                      ._table = (struct command_table *)&var##_argparse_table},                                        \
+        ._arena = {NULL, 1, 0},                                                                                        \
+        ._result = {._parser = &var##_argparse_storage,                                                                \
+                    ._slot_count = var##_argparse_slot_count,                                                          \
+                    ._slots = var##_argparse_slots,                                                                    \
+                    ._gen = 1,                                                                                         \
+                    ._spare = (char *)var##_argparse_chunks,                                                           \
+                    ._spare_size = sizeof(var##_argparse_chunks)}};                                                    \
+    struct parser *const var = &var##_argparse_storage;                                                                \
+    ARGPARSE_DEF_HANDLES(var, var, items)                                                                              \
+    commands(ARGPARSE_DEF_HANDLES, var)                                                                                \
+    ARGPARSE_DEF_CHECK(var, var, items)                                                                                \
+    commands(ARGPARSE_DEF_CHECK, var)
+
+/*!
+ * @brief Commands macro of a parser_define(..) without subcommands
+ */
+#define parser_no_commands(X, P)
+
+// Implementation of parser_define(..). Items are expanded once per purpose, the context P of an item is the tuple
+// (purpose, parser, command, character) and the kind of the item selects the flag (_F), arg (_A) or command (_C)
+// variant. The character is only used by the short index. All arrays end with a zeroed sentinel, thus commands without
+// flags, args or subcommands need no special case.
+#define ARGPARSE_DEF_CAT(a, b) ARGPARSE_DEF_CAT_(a, b)
+#define ARGPARSE_DEF_CAT_(a, b) a##b
+#define ARGPARSE_DEF_PURPOSE(P) ARGPARSE_DEF_ARG0 P
+#define ARGPARSE_DEF_PARSER(P) ARGPARSE_DEF_ARG1 P
+#define ARGPARSE_DEF_CMD(P) ARGPARSE_DEF_ARG2 P
+#define ARGPARSE_DEF_CHAR(P) (ARGPARSE_DEF_ARG3 P)
+#define ARGPARSE_DEF_ARG0(a, b, c, d) a
+#define ARGPARSE_DEF_ARG1(a, b, c, d) b
+#define ARGPARSE_DEF_ARG2(a, b, c, d) c
+#define ARGPARSE_DEF_ARG3(a, b, c, d) d
+#define ARGPARSE_DEF_STORAGE(P) ARGPARSE_DEF_CAT(ARGPARSE_DEF_PARSER(P), _argparse_storage)
+#define ARGPARSE_DEF_MEMBER(P, name) ARGPARSE_DEF_CAT(ARGPARSE_DEF_CMD(P), name)
+#define ARGPARSE_DEF_FLAG_INDEX(P, id) (id##_argparse_slot - ARGPARSE_DEF_MEMBER(P, _argparse_base))
+#define ARGPARSE_DEF_ARG_INDEX(P, id)                                                                                  \
+    (id##_argparse_slot - ARGPARSE_DEF_MEMBER(P, _argparse_base) - ARGPARSE_DEF_MEMBER(P, _argparse_nflags))
+
+#define ARGPARSE_DEF_ITEM(P, kind, ...) ARGPARSE_DEF_ITEM_##kind(P, __VA_ARGS__)
+#define ARGPARSE_DEF_ITEM_FLAG(P, id, s, l, d)                                                                         \
+    ARGPARSE_DEF_CAT(ARGPARSE_DEF_PURPOSE(P), _F)(P, id, s, l, NULL, d, SET_NONE, ARITY_NONE, TYPE_STRING)
+#define ARGPARSE_DEF_ITEM_VALUE(P, id, s, l, ph, d, fl)                                                                \
+    ARGPARSE_DEF_CAT(ARGPARSE_DEF_PURPOSE(P), _F)(P, id, s, l, ph, d, fl, ARITY_ONE, TYPE_STRING)
+#define ARGPARSE_DEF_ITEM_LIST(P, id, s, l, ph, d, fl)                                                                 \
+    ARGPARSE_DEF_CAT(ARGPARSE_DEF_PURPOSE(P), _F)(P, id, s, l, ph, d, fl, ARITY_MANY, TYPE_STRING)
+#define ARGPARSE_DEF_ITEM_VALUE_TYPED(P, id, s, l, ph, d, fl, ty)                                                      \
+    ARGPARSE_DEF_CAT(ARGPARSE_DEF_PURPOSE(P), _F)(P, id, s, l, ph, d, fl, ARITY_ONE, ty)
+#define ARGPARSE_DEF_ITEM_LIST_TYPED(P, id, s, l, ph, d, fl, ty)                                                       \
+    ARGPARSE_DEF_CAT(ARGPARSE_DEF_PURPOSE(P), _F)(P, id, s, l, ph, d, fl, ARITY_MANY, ty)
+#define ARGPARSE_DEF_ITEM_ARG(P, id, n, d) ARGPARSE_DEF_CAT(ARGPARSE_DEF_PURPOSE(P), _A)(P, id, n, d, ARITY_ONE)
+#define ARGPARSE_DEF_ITEM_ARGS(P, id, n, d) ARGPARSE_DEF_CAT(ARGPARSE_DEF_PURPOSE(P), _A)(P, id, n, d, ARITY_MANY)
+#define ARGPARSE_DEF_ITEM_COMMAND(P, id, n, d) ARGPARSE_DEF_CAT(ARGPARSE_DEF_PURPOSE(P), _C)(P, id, n, d)
+
+// Counts of flags, args and subcommands
+#define ARGPARSE_DEF_NF_F(P, id, s, l, ph, d, fl, ar, ty) +1
+#define ARGPARSE_DEF_NF_A(P, id, n, d, ar)
+#define ARGPARSE_DEF_NF_C(P, id, n, d)
+#define ARGPARSE_DEF_NA_F(P, id, s, l, ph, d, fl, ar, ty)
+#define ARGPARSE_DEF_NA_A(P, id, n, d, ar) +1
+#define ARGPARSE_DEF_NA_C(P, id, n, d)
+#define ARGPARSE_DEF_NC_F(P, id, s, l, ph, d, fl, ar, ty)
+#define ARGPARSE_DEF_NC_A(P, id, n, d, ar)
+#define ARGPARSE_DEF_NC_C(P, id, n, d) +1
+
+// Slots of flags followed by the slots of args
+#define ARGPARSE_DEF_SF_F(P, id, s, l, ph, d, fl, ar, ty) id##_argparse_slot,
+#define ARGPARSE_DEF_SF_A(P, id, n, d, ar)
+#define ARGPARSE_DEF_SF_C(P, id, n, d)
+#define ARGPARSE_DEF_SA_F(P, id, s, l, ph, d, fl, ar, ty)
+#define ARGPARSE_DEF_SA_A(P, id, n, d, ar) id##_argparse_slot,
+#define ARGPARSE_DEF_SA_C(P, id, n, d)
+
+// Flag records and the flag arrays of the command table
+#define ARGPARSE_DEF_FL_F(P, id, s, l, ph, d, fl, ar, ty)                                                              \
+    {._short = s,                                                                                                      \
+     ._arity = ar,                                                                                                     \
+     ._type = ty,                                                                                                      \
+     ._flags = fl,                                                                                                     \
+     ._long_len = sizeof(l) - 1,                                                                                       \
+     ._slot = id##_argparse_slot,                                                                                      \
+     ._root = &ARGPARSE_DEF_STORAGE(P),                                                                                \
+     ._long = l,                                                                                                       \
+     ._placeholder = ph,                                                                                               \
+     ._desc = d},
+#define ARGPARSE_DEF_FL_A(P, id, n, d, ar)
+#define ARGPARSE_DEF_FL_C(P, id, n, d)
+// Short index entry of the character given as fourth element of the context, flags without short are skipped
+#define ARGPARSE_DEF_SH_F(P, id, s, l, ph, d, fl, ar, ty)                                                              \
+    +((s) != '\0' && (unsigned char)(s) == ARGPARSE_DEF_CHAR(P) ? ARGPARSE_DEF_FLAG_INDEX(P, id) + 1 : 0)
+#define ARGPARSE_DEF_SH_A(P, id, n, d, ar)
+#define ARGPARSE_DEF_SH_C(P, id, n, d)
+// Case label per short flag, duplicate shorts fail to compile with a duplicate case value
+#define ARGPARSE_DEF_DS_F(P, id, s, l, ph, d, fl, ar, ty)                                                              \
+    case (s) != '\0' ? (int)(unsigned char)(s) : -1 - (int)ARGPARSE_DEF_FLAG_INDEX(P, id):
+#define ARGPARSE_DEF_DS_A(P, id, n, d, ar)
+#define ARGPARSE_DEF_DS_C(P, id, n, d)
+#define ARGPARSE_DEF_LO_F(P, id, s, l, ph, d, fl, ar, ty) l,
+#define ARGPARSE_DEF_LO_A(P, id, n, d, ar)
+#define ARGPARSE_DEF_LO_C(P, id, n, d)
+#define ARGPARSE_DEF_LL_F(P, id, s, l, ph, d, fl, ar, ty) sizeof(l) - 1,
+#define ARGPARSE_DEF_LL_A(P, id, n, d, ar)
+#define ARGPARSE_DEF_LL_C(P, id, n, d)
+#define ARGPARSE_DEF_AT_F(P, id, s, l, ph, d, fl, ar, ty) ar,
+#define ARGPARSE_DEF_AT_A(P, id, n, d, ar)
+#define ARGPARSE_DEF_AT_C(P, id, n, d)
+#define ARGPARSE_DEF_ST_F(P, id, s, l, ph, d, fl, ar, ty) fl,
+#define ARGPARSE_DEF_ST_A(P, id, n, d, ar)
+#define ARGPARSE_DEF_ST_C(P, id, n, d)
+#define ARGPARSE_DEF_TY_F(P, id, s, l, ph, d, fl, ar, ty) ty,
+#define ARGPARSE_DEF_TY_A(P, id, n, d, ar)
+#define ARGPARSE_DEF_TY_C(P, id, n, d)
+#define ARGPARSE_DEF_FR_F(P, id, s, l, ph, d, fl, ar, ty)                                                              \
+    (struct flag *)&ARGPARSE_DEF_MEMBER(P, _argparse_flags)[ARGPARSE_DEF_FLAG_INDEX(P, id)],
+#define ARGPARSE_DEF_FR_A(P, id, n, d, ar)
+#define ARGPARSE_DEF_FR_C(P, id, n, d)
+
+// Arg records and the arg arrays of the command table
+#define ARGPARSE_DEF_AG_F(P, id, s, l, ph, d, fl, ar, ty)
+#define ARGPARSE_DEF_AG_A(P, id, n, d, ar)                                                                             \
+    {._arity = ar, ._slot = id##_argparse_slot, ._root = &ARGPARSE_DEF_STORAGE(P), ._name = n, ._desc = d},
+#define ARGPARSE_DEF_AG_C(P, id, n, d)
+#define ARGPARSE_DEF_AA_F(P, id, s, l, ph, d, fl, ar, ty)
+#define ARGPARSE_DEF_AA_A(P, id, n, d, ar) ar,
+#define ARGPARSE_DEF_AA_C(P, id, n, d)
+#define ARGPARSE_DEF_AR_F(P, id, s, l, ph, d, fl, ar, ty)
+#define ARGPARSE_DEF_AR_A(P, id, n, d, ar)                                                                             \
+    (struct arg *)&ARGPARSE_DEF_MEMBER(P, _argparse_args)[ARGPARSE_DEF_ARG_INDEX(P, id)],
+#define ARGPARSE_DEF_AR_C(P, id, n, d)
+
+// Subcommand records and the subcommand arrays of the command table
+#define ARGPARSE_DEF_CO_F(P, id, s, l, ph, d, fl, ar, ty)
+#define ARGPARSE_DEF_CO_A(P, id, n, d, ar)
+#define ARGPARSE_DEF_CO_C(P, id, n, d)                                                                                 \
+    static struct command const id##_argparse_storage = {                                                              \
+        ._name = n,                                                                                                    \
+        ._desc = d,                                                                                                    \
+        ._name_len = sizeof(n) - 1,                                                                                    \
+        ._slot = id##_argparse_last,                                                                                   \
+        ._root = &ARGPARSE_DEF_STORAGE(P),                                                                             \
+        ._parent = (struct command *)&ARGPARSE_DEF_MEMBER(P, _argparse_storage),                                       \
+        ._table = (struct command_table *)&id##_argparse_table};
+#define ARGPARSE_DEF_CN_F(P, id, s, l, ph, d, fl, ar, ty)
+#define ARGPARSE_DEF_CN_A(P, id, n, d, ar)
+#define ARGPARSE_DEF_CN_C(P, id, n, d) n,
+#define ARGPARSE_DEF_CL_F(P, id, s, l, ph, d, fl, ar, ty)
+#define ARGPARSE_DEF_CL_A(P, id, n, d, ar)
+#define ARGPARSE_DEF_CL_C(P, id, n, d) sizeof(n) - 1,
+#define ARGPARSE_DEF_CR_F(P, id, s, l, ph, d, fl, ar, ty)
+#define ARGPARSE_DEF_CR_A(P, id, n, d, ar)
+#define ARGPARSE_DEF_CR_C(P, id, n, d) (struct command *)&id##_argparse_storage,
+
+// Handles of all items
+#define ARGPARSE_DEF_HD_F(P, id, s, l, ph, d, fl, ar, ty)                                                              \
+    struct flag *const id = (struct flag *)&ARGPARSE_DEF_MEMBER(P, _argparse_flags)[ARGPARSE_DEF_FLAG_INDEX(P, id)];
+#define ARGPARSE_DEF_HD_A(P, id, n, d, ar)                                                                             \
+    struct arg *const id = (struct arg *)&ARGPARSE_DEF_MEMBER(P, _argparse_args)[ARGPARSE_DEF_ARG_INDEX(P, id)];
+#define ARGPARSE_DEF_HD_C(P, id, n, d) struct command *const id = (struct command *)&id##_argparse_storage;
+
+// Expansions per command, invoked through the commands macro as X(P, id, items)
+#define ARGPARSE_DEF_DECLARE(P, id, items)                                                                             \
+    static struct command const id##_argparse_storage;                                                                 \
+    static struct command_table const id##_argparse_table;
+#define ARGPARSE_DEF_COUNTS(P, id, items)                                                                              \
+    enum {                                                                                                             \
+        id##_argparse_nflags = 0 items(ARGPARSE_DEF_ITEM, (ARGPARSE_DEF_NF, P, id, 0)),                                   \
+        id##_argparse_nargs = 0 items(ARGPARSE_DEF_ITEM, (ARGPARSE_DEF_NA, P, id, 0)),                                    \
+        id##_argparse_ncommands = 0 items(ARGPARSE_DEF_ITEM, (ARGPARSE_DEF_NC, P, id, 0))                                 \
+    };
+#define ARGPARSE_DEF_BASE(P, id, items)                                                                                \
+    id##_argparse_base, id##_argparse_last = id##_argparse_base + id##_argparse_nflags + id##_argparse_nargs,
+#define ARGPARSE_DEF_TABLE(P, id, items)                                                                               \
+    enum {                                                                                                             \
+        id##_argparse_before = id##_argparse_base - 1,                                                                 \
+        items(ARGPARSE_DEF_ITEM, (ARGPARSE_DEF_SF, P, id, 0)) items(ARGPARSE_DEF_ITEM, (ARGPARSE_DEF_SA, P, id, 0))          \
+            id##_argparse_self                                                                                         \
+    };                                                                                                                 \
+    static struct flag const id##_argparse_flags[] = {items(ARGPARSE_DEF_ITEM, (ARGPARSE_DEF_FL, P, id, 0)){0}};          \
+    static char const *const id##_argparse_longs[] = {items(ARGPARSE_DEF_ITEM, (ARGPARSE_DEF_LO, P, id, 0)) NULL};        \
+    static size_t const id##_argparse_long_lens[] = {items(ARGPARSE_DEF_ITEM, (ARGPARSE_DEF_LL, P, id, 0)) 0};            \
+    static unsigned char const id##_argparse_arities[] = {items(ARGPARSE_DEF_ITEM, (ARGPARSE_DEF_AT, P, id, 0)) 0};       \
+    static unsigned char const id##_argparse_settings[] = {items(ARGPARSE_DEF_ITEM, (ARGPARSE_DEF_ST, P, id, 0)) 0};      \
+    static unsigned char const id##_argparse_types[] = {items(ARGPARSE_DEF_ITEM, (ARGPARSE_DEF_TY, P, id, 0)) 0};         \
+    static struct flag *const id##_argparse_flag_refs[] = {                                                            \
+        items(ARGPARSE_DEF_ITEM, (ARGPARSE_DEF_FR, P, id, 0))(struct flag *)&id##_argparse_flags[id##_argparse_nflags]};  \
+    static struct arg const id##_argparse_args[] = {items(ARGPARSE_DEF_ITEM, (ARGPARSE_DEF_AG, P, id, 0)){0}};            \
+    static unsigned char const id##_argparse_arg_arities[] = {items(ARGPARSE_DEF_ITEM, (ARGPARSE_DEF_AA, P, id, 0)) 0};   \
+    static struct arg *const id##_argparse_arg_refs[] = {                                                              \
+        items(ARGPARSE_DEF_ITEM, (ARGPARSE_DEF_AR, P, id, 0))(struct arg *)&id##_argparse_args[id##_argparse_nargs]};     \
+    items(ARGPARSE_DEF_ITEM, (ARGPARSE_DEF_CO, P, id, 0))                                                                 \
+    static char const *const id##_argparse_names[] = {items(ARGPARSE_DEF_ITEM, (ARGPARSE_DEF_CN, P, id, 0)) NULL};        \
+    static size_t const id##_argparse_name_lens[] = {items(ARGPARSE_DEF_ITEM, (ARGPARSE_DEF_CL, P, id, 0)) 0};            \
+    static struct command *const id##_argparse_command_refs[] = {items(ARGPARSE_DEF_ITEM, (ARGPARSE_DEF_CR, P, id, 0))   \
+                                                                     NULL};                                            \
+    static struct command_table const id##_argparse_table = {                                                          \
+        ._flag_count = id##_argparse_nflags,                                                                           \
+        ._short_index = {ARGPARSE_DEF_SHORTS(P, id, items)},                                                           \
+        ._longs = id##_argparse_longs,                                                                                 \
+        ._long_lens = id##_argparse_long_lens,                                                                         \
+        ._arities = id##_argparse_arities,                                                                             \
+        ._settings = id##_argparse_settings,                                                                           \
+        ._types = id##_argparse_types,                                                                                 \
+        ._arg_count = id##_argparse_nargs,                                                                             \
+        ._arg_arities = id##_argparse_arg_arities,                                                                     \
+        ._command_count = id##_argparse_ncommands,                                                                     \
+        ._names = id##_argparse_names,                                                                                 \
+        ._name_lens = id##_argparse_name_lens,                                                                         \
+        ._commands = id##_argparse_command_refs,                                                                       \
+        ._slot_base = id##_argparse_base,                                                                              \
+        ._flags = id##_argparse_flag_refs,                                                                             \
+        ._args = id##_argparse_arg_refs};
+#define ARGPARSE_DEF_HANDLES(P, id, items) items(ARGPARSE_DEF_ITEM, (ARGPARSE_DEF_HD, P, id, 0))
+#define ARGPARSE_DEF_CHECK(P, id, items)                                                                               \
+    static inline void id##_argparse_check_shorts(int c) {                                                             \
+        switch (c) {                                                                                                   \
+            items(ARGPARSE_DEF_ITEM, (ARGPARSE_DEF_DS, P, id, 0)) default : break;                                        \
+        }                                                                                                              \
+    }
+
+// All 128 entries of a short index, each one sums the entries of all flags for its character
+#define ARGPARSE_DEF_SHORT(P, id, items, c) 0 items(ARGPARSE_DEF_ITEM, (ARGPARSE_DEF_SH, P, id, c)),
+#define ARGPARSE_DEF_SHORTS4(P, id, items, c)                                                                          \
+    ARGPARSE_DEF_SHORT(P, id, items, c) ARGPARSE_DEF_SHORT(P, id, items, c + 1)                                       \
+        ARGPARSE_DEF_SHORT(P, id, items, c + 2) ARGPARSE_DEF_SHORT(P, id, items, c + 3)
+#define ARGPARSE_DEF_SHORTS16(P, id, items, c)                                                                         \
+    ARGPARSE_DEF_SHORTS4(P, id, items, c) ARGPARSE_DEF_SHORTS4(P, id, items, c + 4)                                   \
+        ARGPARSE_DEF_SHORTS4(P, id, items, c + 8) ARGPARSE_DEF_SHORTS4(P, id, items, c + 12)
+#define ARGPARSE_DEF_SHORTS64(P, id, items, c)                                                                         \
+    ARGPARSE_DEF_SHORTS16(P, id, items, c) ARGPARSE_DEF_SHORTS16(P, id, items, c + 16)                                \
+        ARGPARSE_DEF_SHORTS16(P, id, items, c + 32) ARGPARSE_DEF_SHORTS16(P, id, items, c + 48)
+#define ARGPARSE_DEF_SHORTS(P, id, items) ARGPARSE_DEF_SHORTS64(P, id, items, 0) ARGPARSE_DEF_SHORTS64(P, id, items, 64)
+
 #ifdef __cplusplus
 }
 #endif
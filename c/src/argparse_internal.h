@@ -0,0 +1,304 @@
+/*********************************************************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2024 David Loewe
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************************************************/
+
+/*
+ * Compiled representation of a parser, shared by argparse.c and the sources emitted by the schema generator in
+ * ./tools/. The layout is not part of the stable interface and has to match the library version.
+ */
+
+#ifndef __ARGPARSE_INTERNAL_C__
+#define __ARGPARSE_INTERNAL_C__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "argparse.h"
+
+/*********************************************************************************************************************
+ * arena
+ *********************************************************************************************************************/
+
+/*!
+ * Block of contiguous memory, items are placed directly after the header
+ */
+struct arena_block {
+    struct arena_block *_next;
+    size_t _size;
+    size_t _used;
+};
+
+/*!
+ * Bump allocator holding all items of a parser, released at once by arena_deinit(..)
+ *
+ * A fixed arena is backed by a single caller-provided block and never grows.
+ */
+struct arena {
+    struct arena_block *_head;
+    unsigned int _fixed : 1;
+    unsigned int _exhausted : 1;
+};
+
+/*********************************************************************************************************************
+ * struct slot
+ *********************************************************************************************************************/
+
+/*!
+ * Parse state of a flag, arg or command. All slots of a parser are stored contiguously and apart from the
+ * descriptive schema data, thus parsing only touches the compiled tables and the slots. A slot is only valid if its
+ * generation matches the generation of the parse result holding it.
+ */
+struct slot {
+    size_t _count;
+    // Values within argv, or the first of the consecutive values within the buffer of parser_parse_buffer_r(..).
+    // Both members are NULL if no value was parsed.
+    union {
+        char const *const *_values;
+        char const *_first;
+    };
+    unsigned int _gen;
+    // Set if _number holds the value converted while parsing, a value failing to convert is kept unconverted
+    unsigned int _converted;
+    union {
+        // Converted value of a typed flag value, see enum types
+        union number {
+            int64_t _i64;
+            uint64_t _u64;
+            double _f64;
+            int _bool;
+        } _number;
+        // Runs of a list given more than once, NULL if given once
+        struct list_chunk *_chunks;
+    };
+};
+
+/*!
+ * Values of a single occurrence of a list, within argv or consecutive within the buffer of a buffer parse
+ */
+struct list_run {
+    union {
+        char const *const *_values;
+        char const *_first;
+    };
+    size_t _count;
+};
+
+#define LIST_CHUNK_RUNS 14
+
+/*!
+ * Runs of a list given more than once, the first run is the one also kept in the slot. The chunks of a list are
+ * linked in commandline order, all chunks of a parse result are linked through the pool to reuse them after a reset.
+ */
+struct list_chunk {
+    struct list_chunk *_next;
+    // Last chunk of the list, only maintained by the first chunk
+    struct list_chunk *_last;
+    struct list_chunk *_pool;
+    size_t _count;
+    struct list_run _runs[LIST_CHUNK_RUNS];
+};
+
+/*!
+ * Number of chunks reserved for the repeated lists of a parser declared by parser_define(..) or generated from a
+ * schema, these parsers have no memory to take further chunks from
+ */
+#ifndef ARGPARSE_STATIC_CHUNKS
+#define ARGPARSE_STATIC_CHUNKS 4
+#endif
+
+/*!
+ * Number of values taken by a flag or arg
+ */
+enum arity { ARITY_NONE = 0, ARITY_ONE = 1, ARITY_MANY = 2 };
+
+/*********************************************************************************************************************
+ * name_index
+ *********************************************************************************************************************/
+
+/*!
+ * Open addressing hash index over an array of names with precomputed hashes and lengths. Entries store the
+ * position in the name array + 1, 0 marks an empty entry.
+ */
+struct name_index {
+    size_t _mask;
+    unsigned int const *_entries;
+};
+
+/*********************************************************************************************************************
+ * struct flag, struct arg, struct command
+ *********************************************************************************************************************/
+
+struct parser;
+struct flag_item;
+struct arg_item;
+struct command_item;
+struct command_table;
+
+struct flag {
+    char _short;
+    unsigned char _arity;
+    unsigned char _type;
+    unsigned int _flags;
+    uint32_t _long_hash;
+    size_t _long_len;
+    size_t _slot;
+    struct parser *_root;
+    char const *_long;
+    char const *_placeholder;
+    char const *_desc;
+    // Receives the values of a streamed list instead of the slot, NULL for all other flags
+    void (*_on_value)(void *user, char const *value);
+    void *_user;
+};
+
+struct arg {
+    unsigned char _arity;
+    size_t _slot;
+    struct parser *_root;
+    char const *_name;
+    char const *_desc;
+    // Receives the values of a streamed list instead of the slot, NULL for all other args
+    void (*_on_value)(void *user, char const *value);
+    void *_user;
+};
+
+struct command {
+    char const *_name;
+    char const *_desc;
+    uint32_t _name_hash;
+    size_t _name_len;
+    size_t _slot;
+
+    struct parser *_root;
+    struct command *_parent;
+    struct flag_item *_optionals;
+    struct arg_item *_requires;
+    struct command_item *_commands;
+
+    // Last items of the lists to append in constant time
+    struct flag_item *_optionals_last;
+    struct arg_item *_requires_last;
+    struct command_item *_commands_last;
+
+    struct command_table *_table;
+};
+
+/*!
+ * Results of a single parse. Holds the slots of all flags, args and commands of the compiled schema, thus any number
+ * of results can be filled concurrently from the same parser.
+ */
+struct parse_result {
+    struct parser *_parser;
+    size_t _slot_count;
+    struct slot *_slots;
+    unsigned int _gen;
+
+    // Command whose help was requested or which failed to parse a flag
+    struct command *_help;
+
+    // Buffer of the last parse from a NUL separated buffer, NULL if argv was parsed
+    char const *_buffer;
+
+    // Chunks of repeated lists, the free ones are reused first. New chunks are taken from the spare storage, then
+    // from the parser memory if the result belongs to the parser.
+    struct list_chunk *_chunks;
+    struct list_chunk *_chunks_free;
+    char *_spare;
+    size_t _spare_size;
+};
+
+struct parser {
+    struct command _internal;
+    struct arena _arena;
+
+    // Results of parser_parse_args(..), also marks the parser as compiled once the slots are assigned
+    struct parse_result _result;
+
+    // Long flags may be abbreviated to a unique prefix, see parser_set_abbrev(..)
+    unsigned int _abbrev;
+};
+
+/*********************************************************************************************************************
+ * items
+ *********************************************************************************************************************/
+
+struct flag_item {
+    struct flag _optional;
+    struct flag_item *_next;
+};
+
+struct arg_item {
+    struct arg _required;
+    struct arg_item *_next;
+};
+
+struct command_item {
+    struct command _command;
+    struct command_item *_next;
+};
+
+/*********************************************************************************************************************
+ * Compiled command tables
+ *********************************************************************************************************************/
+
+/*!
+ * Structure-of-arrays representation of a command. Parsing only reads the name, length and arity arrays and
+ * writes to the slots of the parser. The flag and arg records are only consulted for help and error messages.
+ */
+struct command_table {
+    size_t _flag_count;
+    // Maps ASCII short flags to their index + 1, 0 if not registered
+    unsigned int _short_index[128];
+    char const *const *_longs;
+    size_t const *_long_lens;
+    uint32_t const *_long_hashes;
+    struct name_index _long_index;
+    // Flag indices sorted by long name, ties in registration order. Only built if abbreviations are enabled at
+    // compilation, NULL otherwise.
+    unsigned int const *_long_order;
+    unsigned char const *_arities;
+    unsigned char const *_settings;
+    unsigned char const *_types;
+
+    size_t _arg_count;
+    unsigned char const *_arg_arities;
+
+    size_t _command_count;
+    char const *const *_names;
+    size_t const *_name_lens;
+    uint32_t const *_name_hashes;
+    struct name_index _command_index;
+    struct command *const *_commands;
+
+    // First slot of the command, the flags are followed by the args
+    size_t _slot_base;
+
+    // Rendered help, cached on first request or generated along with the tables
+    char const *_help;
+    size_t _help_len;
+
+    struct flag *const *_flags;
+    struct arg *const *_args;
+};
+
+#endif // __ARGPARSE_INTERNAL_C__
@@ -0,0 +1,807 @@
+/*
+ * Schema compiler, emits a parser whose compiled tables are constant data.
+ *
+ * Usage: argparse-c-schema <schema> <output>
+ *
+ * Reads a declarative schema and writes <output>.c and <output>.h. The generated parser needs no construction at
+ * startup: items, lookup tables and the rendered help of every command are emitted as constant initializers, the
+ * hash indices of long flags and subcommands are sized to be collision free. The header declares a `struct parser *`
+ * and one handle per item, thus the generated parser is used with the regular functions of argparse.h.
+ *
+ * Schema format, one directive per line, `#` starts a comment:
+ *
+ *     parser  <ident> "<name>" "<description>" [abbrev]
+ *     flag    <ident> <short> <long> "<description>"
+ *     value   <ident> <short> <long> <placeholder> "<description>" [required] [i64|u64|double|bool]
+ *     list    <ident> <short> <long> <placeholder> "<description>" [required] [repeated] [i64|u64|double|bool]
+ *     arg     <ident> <name> "<description>"
+ *     args    <ident> <name> "<description>"
+ *     command <ident> <name> "<description>"
+ *     end
+ *
+ * A short of `-` or `""` declares a flag with long name only. Items following `command` belong to this command until
+ * the matching `end`. Identifiers are prefixed with the identifier of the parser, e.g. `demo_verbose`. `abbrev` enables
+ * unique-prefix abbreviations of long flags, the sorted name order of each command is emitted along with the hash
+ * indices.
+ */
+#include "argparse.h"
+#include "argparse_internal.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_TOKENS 9
+#define MAX_DEPTH 32
+#define MAX_INDEX_SIZE 65536
+
+/*!
+ * Identifier of a flag, arg or command of the schema
+ */
+struct ident {
+    void const *_item;
+    char const *_name;
+};
+
+struct schema {
+    char const *_path;
+    int _line;
+    char const *_prefix;
+    struct parser *_parser;
+    struct ident *_idents;
+    size_t _ident_count;
+    size_t _ident_capacity;
+};
+
+static void fail(struct schema const *ctx, char const *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    fprintf(stderr, "%s:%d: ", ctx->_path, ctx->_line);
+    vfprintf(stderr, fmt, args);
+    fprintf(stderr, "\n");
+    va_end(args);
+    exit(1);
+}
+
+static void schema_ident(struct schema *ctx, void const *item, char const *name) {
+    if (item == NULL) {
+        fail(ctx, "failed to add '%s'", name);
+    }
+    for (size_t i = 0; i < ctx->_ident_count; ++i) {
+        if (strcmp(ctx->_idents[i]._name, name) == 0) {
+            fail(ctx, "duplicate identifier '%s'", name);
+        }
+    }
+    if (ctx->_ident_count == ctx->_ident_capacity) {
+        ctx->_ident_capacity = ctx->_ident_capacity > 0 ? ctx->_ident_capacity * 2 : 64;
+        ctx->_idents = realloc(ctx->_idents, ctx->_ident_capacity * sizeof(struct ident));
+        if (ctx->_idents == NULL) {
+            fail(ctx, "out of memory");
+        }
+    }
+    ctx->_idents[ctx->_ident_count]._item = item;
+    ctx->_idents[ctx->_ident_count]._name = name;
+    ctx->_ident_count += 1;
+}
+
+static char const *schema_ident_of(struct schema const *ctx, void const *item) {
+    for (size_t i = 0; i < ctx->_ident_count; ++i) {
+        if (ctx->_idents[i]._item == item) {
+            return ctx->_idents[i]._name;
+        }
+    }
+    return NULL;
+}
+
+/*!
+ * Splits the line into words and quoted strings in place, quoted strings support \", \\, \n and \t
+ */
+static int schema_tokenize(struct schema const *ctx, char *line, char **tokens) {
+    int count = 0;
+    char *it = line;
+    while (*it != '\0') {
+        while (*it == ' ' || *it == '\t' || *it == '\r') {
+            ++it;
+        }
+        if (*it == '\0' || *it == '#') {
+            break;
+        }
+        if (count == MAX_TOKENS) {
+            fail(ctx, "too many tokens");
+        }
+        if (*it == '"') {
+            char *out = ++it;
+            tokens[count++] = out;
+            for (; *it != '"'; ++it) {
+                if (*it == '\0') {
+                    fail(ctx, "unterminated string");
+                } else if (*it == '\\') {
+                    ++it;
+                    *out++ = *it == 'n' ? '\n' : (*it == 't' ? '\t' : *it);
+                    if (*it == '\0') {
+                        fail(ctx, "unterminated string");
+                    }
+                } else {
+                    *out++ = *it;
+                }
+            }
+            *out = '\0';
+            ++it;
+        } else {
+            tokens[count++] = it;
+            while (*it != '\0' && *it != ' ' && *it != '\t' && *it != '\r') {
+                ++it;
+            }
+            if (*it != '\0') {
+                *it++ = '\0';
+            }
+        }
+    }
+    return count;
+}
+
+static enum types schema_type(struct schema const *ctx, char const *name) {
+    if (strcmp(name, "i64") == 0) {
+        return TYPE_I64;
+    } else if (strcmp(name, "u64") == 0) {
+        return TYPE_U64;
+    } else if (strcmp(name, "double") == 0) {
+        return TYPE_DOUBLE;
+    } else if (strcmp(name, "bool") == 0) {
+        return TYPE_BOOL;
+    }
+    fail(ctx, "unknown option '%s'", name);
+    return TYPE_STRING;
+}
+
+/*!
+ * Parses the short flag of a flag, value or list, `-` or an empty token stand for none
+ */
+static int schema_short(char const *token, char *out) {
+    if (token[0] == '\0' || strcmp(token, "-") == 0) {
+        *out = '\0';
+        return 0;
+    }
+    *out = token[0];
+    return token[1] == '\0' ? 0 : -1;
+}
+
+/*!
+ * Adds a flag value or list with the optional `required` and, for lists, `repeated` settings and type
+ */
+static void schema_value(struct schema *ctx, struct command *cmd, char **tokens, int count, int list) {
+    char c = '\0';
+    if (count < 6 || count > 8 + list || schema_short(tokens[2], &c) != 0) {
+        fail(ctx, "expected: %s <ident> <short> <long> <placeholder> \"<description>\" [required]%s [type]",
+             tokens[0], list == 1 ? " [repeated]" : "");
+    }
+    unsigned int flags = SET_NONE;
+    enum types type = TYPE_STRING;
+    for (int i = 6; i < count; ++i) {
+        if (strcmp(tokens[i], "required") == 0) {
+            flags |= SET_REQUIRED;
+        } else if (list == 1 && strcmp(tokens[i], "repeated") == 0) {
+            flags |= SET_REPEATED;
+        } else {
+            type = schema_type(ctx, tokens[i]);
+        }
+    }
+    struct flag *f = list == 1 ? command_add_flag_list_typed(cmd, c, tokens[3], tokens[4], tokens[5], flags, type)
+                               : command_add_flag_value_typed(cmd, c, tokens[3], tokens[4], tokens[5], flags, type);
+    schema_ident(ctx, f, tokens[1]);
+}
+
+/*!
+ * Reads the schema and registers all items with the parser, the tokens point into the buffer
+ */
+static void schema_read(struct schema *ctx, char *buffer, void *storage, size_t size) {
+    struct command *stack[MAX_DEPTH];
+    int depth = -1;
+    char *line = buffer;
+    for (ctx->_line = 1; line != NULL && *line != '\0'; ctx->_line += 1) {
+        char *next = strchr(line, '\n');
+        if (next != NULL) {
+            *next++ = '\0';
+        }
+        char *tokens[MAX_TOKENS];
+        int count = schema_tokenize(ctx, line, tokens);
+        line = next;
+        if (count == 0) {
+            continue;
+        }
+
+        if (depth < 0) {
+            if (strcmp(tokens[0], "parser") != 0 || count < 4 || count > 5 ||
+                (count == 5 && strcmp(tokens[4], "abbrev") != 0)) {
+                fail(ctx, "expected: parser <ident> \"<name>\" \"<description>\" [abbrev]");
+            }
+            ctx->_prefix = tokens[1];
+            ctx->_parser = parser_init_static(storage, size, tokens[2], tokens[3]);
+            if (ctx->_parser == NULL) {
+                fail(ctx, "out of memory");
+            }
+            parser_set_abbrev(ctx->_parser, count == 5 ? 1 : 0);
+            stack[++depth] = &ctx->_parser->_internal;
+            continue;
+        }
+
+        struct command *cmd = stack[depth];
+        if (strcmp(tokens[0], "flag") == 0) {
+            char c = '\0';
+            if (count != 5 || schema_short(tokens[2], &c) != 0) {
+                fail(ctx, "expected: flag <ident> <short> <long> \"<description>\"");
+            }
+            schema_ident(ctx, command_add_flag(cmd, c, tokens[3], tokens[4], SET_NONE), tokens[1]);
+        } else if (strcmp(tokens[0], "value") == 0) {
+            schema_value(ctx, cmd, tokens, count, 0);
+        } else if (strcmp(tokens[0], "list") == 0) {
+            schema_value(ctx, cmd, tokens, count, 1);
+        } else if (strcmp(tokens[0], "arg") == 0 || strcmp(tokens[0], "args") == 0) {
+            if (count != 4) {
+                fail(ctx, "expected: %s <ident> <name> \"<description>\"", tokens[0]);
+            }
+            struct arg *a = tokens[0][3] == 's' ? command_add_arg_list(cmd, tokens[2], tokens[3])
+                                                : command_add_arg_value(cmd, tokens[2], tokens[3]);
+            schema_ident(ctx, a, tokens[1]);
+        } else if (strcmp(tokens[0], "command") == 0) {
+            if (count != 4) {
+                fail(ctx, "expected: command <ident> <name> \"<description>\"");
+            }
+            if (depth + 1 == MAX_DEPTH) {
+                fail(ctx, "commands nested too deep");
+            }
+            struct command *sub = command_add_subcommand(cmd, tokens[2], tokens[3]);
+            schema_ident(ctx, sub, tokens[1]);
+            stack[++depth] = sub;
+        } else if (strcmp(tokens[0], "end") == 0) {
+            if (depth == 0) {
+                fail(ctx, "unexpected end");
+            }
+            depth -= 1;
+        } else {
+            fail(ctx, "unknown directive '%s'", tokens[0]);
+        }
+    }
+    if (depth != 0) {
+        fail(ctx, depth < 0 ? "missing parser" : "missing end");
+    }
+}
+
+/*********************************************************************************************************************
+ * Emitting C source
+ *********************************************************************************************************************/
+
+static void emit_string_len(FILE *out, char const *str, size_t len) {
+    fputc('"', out);
+    unsigned char const *end = (unsigned char const *)str + len;
+    for (unsigned char const *c = (unsigned char const *)str; c < end; ++c) {
+        if (*c == '"' || *c == '\\') {
+            fprintf(out, "\\%c", *c);
+        } else if (*c == '\n') {
+            // Break the literal after each line to keep the help readable
+            fprintf(out, c + 1 < end ? "\\n\"\n    \"" : "\\n");
+        } else if (*c < 32 || *c >= 127) {
+            fprintf(out, "\\%03o", *c);
+        } else {
+            fputc(*c, out);
+        }
+    }
+    fputc('"', out);
+}
+
+static void emit_string(FILE *out, char const *str) {
+    if (str == NULL) {
+        fprintf(out, "NULL");
+        return;
+    }
+    emit_string_len(out, str, strlen(str));
+}
+
+/*!
+ * Returns the size of a collision free index for the hashes, falls back to probing beyond MAX_INDEX_SIZE
+ */
+static size_t emit_index_size(uint32_t const *hashes, size_t count) {
+    size_t size = 4;
+    while (size < count * 2) {
+        size *= 2;
+    }
+    for (; size < MAX_INDEX_SIZE; size *= 2) {
+        int collision = 0;
+        for (size_t i = 0; i < count && collision == 0; ++i) {
+            for (size_t j = 0; j < i; ++j) {
+                if ((hashes[i] & (size - 1)) == (hashes[j] & (size - 1))) {
+                    collision = 1;
+                    break;
+                }
+            }
+        }
+        if (collision == 0) {
+            break;
+        }
+    }
+    return size;
+}
+
+/*!
+ * Emits the hash index, entries are inserted like name_index_build(..) in argparse.c
+ */
+static void emit_index(FILE *out, char const *prefix, char const *name, size_t id, uint32_t const *hashes,
+                       size_t count) {
+    if (count == 0) {
+        return;
+    }
+    size_t size = emit_index_size(hashes, count);
+    unsigned int *entries = calloc(size, sizeof(unsigned int));
+    for (size_t i = 0; i < count; ++i) {
+        size_t e = hashes[i] & (size - 1);
+        while (entries[e] != 0) {
+            e = (e + 1) & (size - 1);
+        }
+        entries[e] = (unsigned int)(i + 1);
+    }
+    fprintf(out, "static unsigned int const %s_%s_%zu[%zu] = {", prefix, name, id, size);
+    for (size_t e = 0; e < size; ++e) {
+        fprintf(out, "%s%u", e % 16 == 0 ? "\n    " : " ", entries[e]);
+        fputc(e + 1 < size ? ',' : '\n', out);
+    }
+    fprintf(out, "};\n");
+    free(entries);
+}
+
+/*!
+ * Expression of the command with the given id, the root command is embedded into the parser
+ */
+static void emit_command_ref(char *buf, size_t size, char const *prefix, size_t parent, size_t index, int root) {
+    if (root == 1) {
+        snprintf(buf, size, "&%s_storage._internal", prefix);
+    } else {
+        snprintf(buf, size, "(struct command *)&%s_commands_%zu[%zu]._command", prefix, parent, index);
+    }
+}
+
+static size_t count_flags(struct command const *cmd) {
+    size_t count = 0;
+    for (struct flag_item const *o = cmd->_optionals; o != NULL; o = o->_next) {
+        count += 1;
+    }
+    return count;
+}
+
+static size_t count_args(struct command const *cmd) {
+    size_t count = 0;
+    for (struct arg_item const *r = cmd->_requires; r != NULL; r = r->_next) {
+        count += 1;
+    }
+    return count;
+}
+
+static size_t count_commands(struct command const *cmd) {
+    size_t count = 0;
+    for (struct command_item const *c = cmd->_commands; c != NULL; c = c->_next) {
+        count += 1;
+    }
+    return count;
+}
+
+/*!
+ * Returns the number of commands of the subtree including the command itself
+ */
+static size_t count_subtree(struct command const *cmd) {
+    size_t count = 1;
+    for (struct command_item const *c = cmd->_commands; c != NULL; c = c->_next) {
+        count += count_subtree(&c->_command);
+    }
+    return count;
+}
+
+/*!
+ * Emits the forward declarations of the item arrays of the command and all subcommands, returns the next free id
+ */
+static size_t emit_declarations(FILE *out, char const *prefix, struct command const *cmd, size_t id) {
+    size_t flags = count_flags(cmd);
+    size_t args = count_args(cmd);
+    size_t commands = count_commands(cmd);
+    if (flags > 0) {
+        fprintf(out, "static struct flag_item const %s_flags_%zu[%zu];\n", prefix, id, flags);
+    }
+    if (args > 0) {
+        fprintf(out, "static struct arg_item const %s_args_%zu[%zu];\n", prefix, id, args);
+    }
+    if (commands > 0) {
+        fprintf(out, "static struct command_item const %s_commands_%zu[%zu];\n", prefix, id, commands);
+    }
+    fprintf(out, "static struct command_table const %s_table_%zu;\n", prefix, id);
+
+    size_t next = id + 1;
+    for (struct command_item const *c = cmd->_commands; c != NULL; c = c->_next) {
+        next = emit_declarations(out, prefix, &c->_command, next);
+    }
+    return next;
+}
+
+/*!
+ * Emits the initializer of the command record, the lists refer to the item arrays of the command
+ */
+static void emit_command(FILE *out, char const *prefix, struct command const *cmd, size_t id, char const *parent) {
+    size_t flags = count_flags(cmd);
+    size_t args = count_args(cmd);
+    size_t commands = count_commands(cmd);
+
+    fprintf(out, "{\n        ._name = ");
+    emit_string(out, cmd->_name);
+    fprintf(out, ",\n        ._desc = ");
+    emit_string(out, cmd->_desc);
+    fprintf(out, ",\n        ._name_hash = 0x%08xu,\n        ._name_len = %zu,\n        ._slot = %zu,\n",
+            (unsigned int)cmd->_name_hash, cmd->_name_len, cmd->_slot);
+    fprintf(out, "        ._root = &%s_storage,\n        ._parent = %s,\n", prefix, parent);
+    if (flags > 0) {
+        fprintf(out, "        ._optionals = (struct flag_item *)&%s_flags_%zu[0],\n", prefix, id);
+        fprintf(out, "        ._optionals_last = (struct flag_item *)&%s_flags_%zu[%zu],\n", prefix, id, flags - 1);
+    }
+    if (args > 0) {
+        fprintf(out, "        ._requires = (struct arg_item *)&%s_args_%zu[0],\n", prefix, id);
+        fprintf(out, "        ._requires_last = (struct arg_item *)&%s_args_%zu[%zu],\n", prefix, id, args - 1);
+    }
+    if (commands > 0) {
+        fprintf(out, "        ._commands = (struct command_item *)&%s_commands_%zu[0],\n", prefix, id);
+        fprintf(out, "        ._commands_last = (struct command_item *)&%s_commands_%zu[%zu],\n", prefix, id,
+                commands - 1);
+    }
+    fprintf(out, "        ._table = (struct command_table *)&%s_table_%zu,\n    }", prefix, id);
+}
+
+/*!
+ * Emits items and tables of the command and all subcommands, returns the next free id
+ */
+static size_t emit_tables(FILE *out, struct schema const *ctx, struct command *cmd, size_t id, char const *self) {
+    char const *prefix = ctx->_prefix;
+    struct command_table const *t = cmd->_table;
+    size_t flags = count_flags(cmd);
+    size_t args = count_args(cmd);
+    size_t commands = count_commands(cmd);
+
+    fprintf(out, "\n/* %s */\n\n", cmd->_name);
+
+    // Flag records with the table arrays used while parsing
+    if (flags > 0) {
+        size_t i = 0;
+        fprintf(out, "static struct flag_item const %s_flags_%zu[%zu] = {\n", prefix, id, flags);
+        for (struct flag_item const *o = cmd->_optionals; o != NULL; o = o->_next, ++i) {
+            struct flag const *f = &o->_optional;
+            fprintf(out, "    {{._short = %d, ._arity = %u, ._type = %u, ._flags = %u, ._long_hash = 0x%08xu, ",
+                    f->_short, f->_arity, f->_type, f->_flags, (unsigned int)f->_long_hash);
+            fprintf(out, "._long_len = %zu, ._slot = %zu,\n      ._root = &%s_storage, ._long = ", f->_long_len,
+                    f->_slot, prefix);
+            emit_string(out, f->_long);
+            fprintf(out, ", ._placeholder = ");
+            emit_string(out, f->_placeholder);
+            fprintf(out, ", ._desc = ");
+            emit_string(out, f->_desc);
+            if (o->_next != NULL) {
+                fprintf(out, "},\n     (struct flag_item *)&%s_flags_%zu[%zu]},\n", prefix, id, i + 1);
+            } else {
+                fprintf(out, "},\n     NULL},\n");
+            }
+        }
+        fprintf(out, "};\n");
+
+        fprintf(out, "static char const *const %s_longs_%zu[%zu] = {", prefix, id, flags);
+        for (i = 0; i < flags; ++i) {
+            fprintf(out, "\n    ");
+            emit_string(out, t->_longs[i]);
+            fputc(',', out);
+        }
+        fprintf(out, "\n};\nstatic size_t const %s_long_lens_%zu[%zu] = {", prefix, id, flags);
+        for (i = 0; i < flags; ++i) {
+            fprintf(out, "%s%zu", i > 0 ? ", " : "", t->_long_lens[i]);
+        }
+        fprintf(out, "};\nstatic uint32_t const %s_long_hashes_%zu[%zu] = {", prefix, id, flags);
+        for (i = 0; i < flags; ++i) {
+            fprintf(out, "%s0x%08xu", i > 0 ? ", " : "", (unsigned int)t->_long_hashes[i]);
+        }
+        fprintf(out, "};\nstatic unsigned char const %s_arities_%zu[%zu] = {", prefix, id, flags);
+        for (i = 0; i < flags; ++i) {
+            fprintf(out, "%s%u", i > 0 ? ", " : "", t->_arities[i]);
+        }
+        fprintf(out, "};\nstatic unsigned char const %s_settings_%zu[%zu] = {", prefix, id, flags);
+        for (i = 0; i < flags; ++i) {
+            fprintf(out, "%s%u", i > 0 ? ", " : "", t->_settings[i]);
+        }
+        fprintf(out, "};\nstatic unsigned char const %s_types_%zu[%zu] = {", prefix, id, flags);
+        for (i = 0; i < flags; ++i) {
+            fprintf(out, "%s%u", i > 0 ? ", " : "", t->_types[i]);
+        }
+        fprintf(out, "};\nstatic struct flag *const %s_flag_refs_%zu[%zu] = {", prefix, id, flags);
+        for (i = 0; i < flags; ++i) {
+            fprintf(out, "\n    (struct flag *)&%s_flags_%zu[%zu]._optional,", prefix, id, i);
+        }
+        fprintf(out, "\n};\n");
+        emit_index(out, prefix, "long_index", id, t->_long_hashes, flags);
+        if (t->_long_order != NULL) {
+            fprintf(out, "static unsigned int const %s_long_order_%zu[%zu] = {", prefix, id, flags);
+            for (i = 0; i < flags; ++i) {
+                fprintf(out, "%s%u", i > 0 ? ", " : "", t->_long_order[i]);
+            }
+            fprintf(out, "};\n");
+        }
+    }
+
+    if (args > 0) {
+        size_t i = 0;
+        fprintf(out, "static struct arg_item const %s_args_%zu[%zu] = {\n", prefix, id, args);
+        for (struct arg_item const *r = cmd->_requires; r != NULL; r = r->_next, ++i) {
+            struct arg const *a = &r->_required;
+            fprintf(out, "    {{._arity = %u, ._slot = %zu, ._root = &%s_storage, ._name = ", a->_arity, a->_slot,
+                    prefix);
+            emit_string(out, a->_name);
+            fprintf(out, ", ._desc = ");
+            emit_string(out, a->_desc);
+            if (r->_next != NULL) {
+                fprintf(out, "},\n     (struct arg_item *)&%s_args_%zu[%zu]},\n", prefix, id, i + 1);
+            } else {
+                fprintf(out, "},\n     NULL},\n");
+            }
+        }
+        fprintf(out, "};\nstatic unsigned char const %s_arg_arities_%zu[%zu] = {", prefix, id, args);
+        for (i = 0; i < args; ++i) {
+            fprintf(out, "%s%u", i > 0 ? ", " : "", t->_arg_arities[i]);
+        }
+        fprintf(out, "};\nstatic struct arg *const %s_arg_refs_%zu[%zu] = {", prefix, id, args);
+        for (i = 0; i < args; ++i) {
+            fprintf(out, "\n    (struct arg *)&%s_args_%zu[%zu]._required,", prefix, id, i);
+        }
+        fprintf(out, "\n};\n");
+    }
+
+    // Subcommands are emitted after this command, their ids follow in preorder
+    size_t next = id + 1;
+    if (commands > 0) {
+        size_t i = 0;
+        size_t *ids = calloc(commands, sizeof(size_t));
+        for (struct command_item const *c = cmd->_commands; c != NULL; c = c->_next, ++i) {
+            ids[i] = next;
+            next += count_subtree(&c->_command);
+        }
+
+        i = 0;
+        fprintf(out, "static struct command_item const %s_commands_%zu[%zu] = {\n", prefix, id, commands);
+        for (struct command_item const *c = cmd->_commands; c != NULL; c = c->_next, ++i) {
+            fprintf(out, "    {");
+            emit_command(out, prefix, &c->_command, ids[i], self);
+            if (c->_next != NULL) {
+                fprintf(out, ",\n     (struct command_item *)&%s_commands_%zu[%zu]},\n", prefix, id, i + 1);
+            } else {
+                fprintf(out, ",\n     NULL},\n");
+            }
+        }
+        fprintf(out, "};\nstatic char const *const %s_names_%zu[%zu] = {", prefix, id, commands);
+        for (i = 0; i < commands; ++i) {
+            fprintf(out, "\n    ");
+            emit_string(out, t->_names[i]);
+            fputc(',', out);
+        }
+        fprintf(out, "\n};\nstatic size_t const %s_name_lens_%zu[%zu] = {", prefix, id, commands);
+        for (i = 0; i < commands; ++i) {
+            fprintf(out, "%s%zu", i > 0 ? ", " : "", t->_name_lens[i]);
+        }
+        fprintf(out, "};\nstatic uint32_t const %s_name_hashes_%zu[%zu] = {", prefix, id, commands);
+        for (i = 0; i < commands; ++i) {
+            fprintf(out, "%s0x%08xu", i > 0 ? ", " : "", (unsigned int)t->_name_hashes[i]);
+        }
+        fprintf(out, "};\nstatic struct command *const %s_command_refs_%zu[%zu] = {", prefix, id, commands);
+        for (i = 0; i < commands; ++i) {
+            fprintf(out, "\n    (struct command *)&%s_commands_%zu[%zu]._command,", prefix, id, i);
+        }
+        fprintf(out, "\n};\n");
+        emit_index(out, prefix, "command_index", id, t->_name_hashes, commands);
+
+        i = 0;
+        for (struct command_item *c = cmd->_commands; c != NULL; c = c->_next, ++i) {
+            char ref[256];
+            emit_command_ref(ref, sizeof(ref), prefix, id, i, 0);
+            emit_tables(out, ctx, &c->_command, ids[i], ref);
+        }
+        free(ids);
+    }
+
+    // Help rendered by the library itself
+    size_t len = command_help(cmd, NULL, 0);
+    char *help = malloc(len + 1);
+    command_help(cmd, help, len + 1);
+    fprintf(out, "static char const %s_help_%zu[] =\n    ", prefix, id);
+    // Written by its length, thus the literal always holds the _help_len bytes emitted below
+    emit_string_len(out, help, len);
+    fprintf(out, ";\n");
+    free(help);
+
+    fprintf(out, "static struct command_table const %s_table_%zu = {\n", prefix, id);
+    fprintf(out, "    ._flag_count = %zu,\n    ._short_index = {", flags);
+    char const *sep = "";
+    for (int c = 0; c < 128; ++c) {
+        if (t->_short_index[c] != 0) {
+            if (c > 32 && c < 127 && c != '\'' && c != '\\') {
+                fprintf(out, "%s['%c'] = %u", sep, c, t->_short_index[c]);
+            } else {
+                fprintf(out, "%s[%d] = %u", sep, c, t->_short_index[c]);
+            }
+            sep = ", ";
+        }
+    }
+    // An empty initializer is not valid before C23
+    fprintf(out, "%s},\n", sep[0] == '\0' ? "0" : "");
+    if (flags > 0) {
+        fprintf(out, "    ._longs = %s_longs_%zu,\n    ._long_lens = %s_long_lens_%zu,\n", prefix, id, prefix, id);
+        fprintf(out, "    ._long_hashes = %s_long_hashes_%zu,\n", prefix, id);
+        fprintf(out, "    ._long_index = {%zu, %s_long_index_%zu},\n", emit_index_size(t->_long_hashes, flags) - 1,
+                prefix, id);
+        if (t->_long_order != NULL) {
+            fprintf(out, "    ._long_order = %s_long_order_%zu,\n", prefix, id);
+        }
+        fprintf(out, "    ._arities = %s_arities_%zu,\n    ._settings = %s_settings_%zu,\n", prefix, id, prefix, id);
+        fprintf(out, "    ._types = %s_types_%zu,\n    ._flags = %s_flag_refs_%zu,\n", prefix, id, prefix, id);
+    }
+    fprintf(out, "    ._arg_count = %zu,\n", args);
+    if (args > 0) {
+        fprintf(out, "    ._arg_arities = %s_arg_arities_%zu,\n    ._args = %s_arg_refs_%zu,\n", prefix, id, prefix,
+                id);
+    }
+    fprintf(out, "    ._command_count = %zu,\n", commands);
+    if (commands > 0) {
+        fprintf(out, "    ._names = %s_names_%zu,\n    ._name_lens = %s_name_lens_%zu,\n", prefix, id, prefix, id);
+        fprintf(out, "    ._name_hashes = %s_name_hashes_%zu,\n", prefix, id);
+        fprintf(out, "    ._command_index = {%zu, %s_command_index_%zu},\n",
+                emit_index_size(t->_name_hashes, commands) - 1, prefix, id);
+        fprintf(out, "    ._commands = %s_command_refs_%zu,\n", prefix, id);
+    }
+    fprintf(out, "    ._slot_base = %zu,\n", t->_slot_base);
+    fprintf(out, "    ._help = %s_help_%zu,\n    ._help_len = %zu,\n};\n", prefix, id, len);
+    return next;
+}
+
+/*!
+ * Emits the handles of all items of the command and its subcommands, as definition or as extern declaration
+ */
+static size_t emit_handles(FILE *out, struct schema const *ctx, struct command const *cmd, size_t id, int header) {
+    char const *prefix = ctx->_prefix;
+    size_t i = 0;
+    for (struct flag_item const *o = cmd->_optionals; o != NULL; o = o->_next, ++i) {
+        if (header == 1) {
+            fprintf(out, "extern struct flag *const %s_%s;\n", prefix, schema_ident_of(ctx, &o->_optional));
+        } else {
+            fprintf(out, "struct flag *const %s_%s = (struct flag *)&%s_flags_%zu[%zu]._optional;\n", prefix,
+                    schema_ident_of(ctx, &o->_optional), prefix, id, i);
+        }
+    }
+    i = 0;
+    for (struct arg_item const *r = cmd->_requires; r != NULL; r = r->_next, ++i) {
+        if (header == 1) {
+            fprintf(out, "extern struct arg *const %s_%s;\n", prefix, schema_ident_of(ctx, &r->_required));
+        } else {
+            fprintf(out, "struct arg *const %s_%s = (struct arg *)&%s_args_%zu[%zu]._required;\n", prefix,
+                    schema_ident_of(ctx, &r->_required), prefix, id, i);
+        }
+    }
+    i = 0;
+    size_t next = id + 1;
+    for (struct command_item const *c = cmd->_commands; c != NULL; c = c->_next, ++i) {
+        if (header == 1) {
+            fprintf(out, "extern struct command *const %s_%s;\n", prefix, schema_ident_of(ctx, &c->_command));
+        } else {
+            fprintf(out, "struct command *const %s_%s = (struct command *)&%s_commands_%zu[%zu]._command;\n", prefix,
+                    schema_ident_of(ctx, &c->_command), prefix, id, i);
+        }
+        next = emit_handles(out, ctx, &c->_command, next, header);
+    }
+    return next;
+}
+
+static void emit_header(FILE *out, struct schema const *ctx, char const *guard) {
+    fprintf(out, "/* Generated by argparse-c-schema from %s, do not edit. */\n\n", ctx->_path);
+    fprintf(out, "#ifndef %s\n#define %s\n\n#include \"argparse.h\"\n\n", guard, guard);
+    fprintf(out, "#ifdef __cplusplus\nextern \"C\" {\n#endif\n\n");
+    fprintf(out, "/*!\n * @brief Parser of the schema, its tables are constant data and need no construction\n */\n");
+    fprintf(out, "extern struct parser *const %s;\n\n", ctx->_prefix);
+    emit_handles(out, ctx, &ctx->_parser->_internal, 0, 1);
+    fprintf(out, "\n#ifdef __cplusplus\n}\n#endif\n\n#endif // %s\n", guard);
+}
+
+static void emit_source(FILE *out, struct schema const *ctx, char const *header) {
+    char const *prefix = ctx->_prefix;
+    struct parser *parser = ctx->_parser;
+    fprintf(out, "/* Generated by argparse-c-schema from %s, do not edit. */\n\n", ctx->_path);
+    fprintf(out, "#include \"%s\"\n#include \"argparse_internal.h\"\n\n", header);
+    fprintf(out, "static struct parser %s_storage;\n", prefix);
+    emit_declarations(out, prefix, &parser->_internal, 0);
+    fprintf(out, "\n/* Parse state, the only mutable data of the parser */\n\n");
+    fprintf(out, "static struct slot %s_slots[%zu];\n", prefix, parser->_result._slot_count);
+    fprintf(out, "static struct list_chunk %s_chunks[ARGPARSE_STATIC_CHUNKS];\n", prefix);
+
+    char root[256];
+    emit_command_ref(root, sizeof(root), prefix, 0, 0, 1);
+    emit_tables(out, ctx, &ctx->_parser->_internal, 0, root);
+
+    fprintf(out, "\n/* Parser */\n\nstatic struct parser %s_storage = {\n    ._internal = ", prefix);
+    emit_command(out, prefix, &parser->_internal, 0, "NULL");
+    fprintf(out, ",\n    ._arena = {NULL, 1, 0},\n");
+    fprintf(out, "    ._result = {._parser = &%s_storage, ._slot_count = %zu, ._slots = %s_slots, ._gen = 1,\n", prefix,
+            parser->_result._slot_count, prefix);
+    fprintf(out, "                ._spare = (char *)%s_chunks, ._spare_size = sizeof(%s_chunks)},\n", prefix, prefix);
+    fprintf(out, "    ._abbrev = %u,\n};\n\n", parser->_abbrev);
+    fprintf(out, "struct parser *const %s = &%s_storage;\n", prefix, prefix);
+    emit_handles(out, ctx, &parser->_internal, 0, 0);
+}
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s <schema> <output>\n", argv[0]);
+        return 1;
+    }
+
+    struct schema ctx = {argv[1], 0, NULL, NULL, NULL, 0, 0};
+    FILE *in = fopen(argv[1], "rb");
+    if (in == NULL) {
+        fail(&ctx, "failed to open");
+    }
+    fseek(in, 0, SEEK_END);
+    long size = ftell(in);
+    fseek(in, 0, SEEK_SET);
+    char *buffer = malloc((size_t)size + 1);
+    if (buffer == NULL || fread(buffer, 1, (size_t)size, in) != (size_t)size) {
+        fail(&ctx, "failed to read");
+    }
+    buffer[size] = '\0';
+    fclose(in);
+
+    // The parser of the generator only lives until the sources are written
+    size_t storage_size = 1024 + (size_t)size * 64;
+    void *storage = malloc(storage_size);
+    schema_read(&ctx, buffer, storage, storage_size);
+    if (parser_error(ctx._parser) != ERR_NONE || parser_compile(ctx._parser) != 0) {
+        fail(&ctx, "failed to compile");
+    }
+
+    size_t len = strlen(argv[2]);
+    char *path = malloc(len + 3);
+    char const *base = strrchr(argv[2], '/') != NULL ? strrchr(argv[2], '/') + 1 : argv[2];
+    char *header = malloc(strlen(base) + 3);
+    char *guard = malloc(strlen(base) + 7);
+    sprintf(header, "%s.h", base);
+    size_t g = 0;
+    guard[g++] = '_';
+    guard[g++] = '_';
+    for (char const *c = base; *c != '\0'; ++c) {
+        if (*c >= 'a' && *c <= 'z') {
+            guard[g++] = (char)(*c - 'a' + 'A');
+        } else if ((*c >= 'A' && *c <= 'Z') || (*c >= '0' && *c <= '9')) {
+            guard[g++] = *c;
+        } else {
+            guard[g++] = '_';
+        }
+    }
+    strcpy(&guard[g], "_H__");
+
+    sprintf(path, "%s.h", argv[2]);
+    FILE *out = fopen(path, "w");
+    if (out == NULL) {
+        fail(&ctx, "failed to write %s", path);
+    }
+    emit_header(out, &ctx, guard);
+    fclose(out);
+
+    sprintf(path, "%s.c", argv[2]);
+    out = fopen(path, "w");
+    if (out == NULL) {
+        fail(&ctx, "failed to write %s", path);
+    }
+    emit_source(out, &ctx, header);
+    fclose(out);
+
+    free(guard);
+    free(header);
+    free(path);
+    free(storage);
+    free(buffer);
+    free(ctx._idents);
+    return 0;
+}
@@ -0,0 +1,37 @@
+/*
+ * Replaces the global operator new to count the heap allocations of a benchmark.
+ *
+ * The replacements are defined here, thus the header is included by exactly one translation unit of each benchmark.
+ * The aligned overloads are replaced as well, since std::pmr::new_delete_resource() allocates through them.
+ */
+#ifndef __ARGPARSE_CXX_ALLOC_COUNT__
+#define __ARGPARSE_CXX_ALLOC_COUNT__
+
+#include <cstdlib>
+#include <new>
+
+static size_t allocations = 0;
+
+void *operator new(size_t size) {
+    allocations += 1;
+    if (auto *ptr = std::malloc(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new(size_t size, std::align_val_t align) {
+    allocations += 1;
+    auto alignment = static_cast<size_t>(align);
+    if (auto *ptr = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t /*size*/) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::align_val_t /*align*/) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t /*size*/, std::align_val_t /*align*/) noexcept { std::free(ptr); }
+
+#endif
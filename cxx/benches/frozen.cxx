@@ -0,0 +1,129 @@
+/*
+ * Compares parsing over the tables compiled by parser::finalize() with the former walk over the command tree.
+ *
+ * Each round registers N long flags and parses a commandline providing every flag once in shuffled order. The former
+ * walk is replicated below: one heap node per option, names resolved by binary search over pointers to the nodes and
+ * a virtual call for every match.
+ */
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "argparse.hxx"
+
+/*
+ * Replica of the former optional flag, allocated one by one
+ */
+class walk_optional {
+  public:
+    walk_optional(std::string_view _long) : _long(_long) {}
+    virtual ~walk_optional() = default;
+
+    auto name() const -> std::string_view { return _long; }
+
+    virtual auto takes() -> size_t = 0;
+    virtual auto parse(char const *const *argv, int len) -> int = 0;
+
+  private:
+    std::string_view _long;
+};
+
+class walk_flag : public walk_optional {
+  public:
+    using walk_optional::walk_optional;
+
+    auto takes() -> size_t override { return 0; }
+    auto parse(char const *const *argv, int len) -> int override {
+        _cnt += 1;
+        return 0;
+    }
+
+  private:
+    size_t _cnt = 0;
+};
+
+/*
+ * Replica of the former command, the long flags are kept sorted on registration
+ */
+class walk_command {
+  public:
+    auto add(std::string_view name) -> void {
+        _optional.push_back(std::make_unique<walk_flag>(name));
+        auto pos = std::ranges::lower_bound(_sorted, name, {}, &walk_optional::name);
+        _sorted.insert(pos, _optional.back().get());
+    }
+
+    auto parse(char const *const *argv, int argc) -> int {
+        for (auto pos = 1; pos < argc;) {
+            auto arg = std::string_view(argv[pos]).substr(2);
+            auto it = std::ranges::lower_bound(_sorted, arg, {}, &walk_optional::name);
+            if (it == _sorted.end() || (*it)->name() != arg) {
+                return -1;
+            }
+            pos += (*it)->parse(&argv[pos + 1], 0) + 1;
+        }
+        return argc;
+    }
+
+  private:
+    std::vector<std::unique_ptr<walk_optional>> _optional;
+    std::vector<walk_optional *> _sorted;
+};
+
+int main(int argc, char *argv[]) {
+    constexpr auto rounds = 100;
+    std::cout << "   options   walk ns/flag  tables ns/flag   finalize us" << std::endl;
+    for (auto n : {1000, 4000, 16000, 64000}) {
+        auto names = std::vector<std::string>();
+        auto flags = std::vector<std::string>();
+        for (auto i = 0; i < n; ++i) {
+            names.push_back("option-" + std::to_string(i));
+            flags.push_back("--" + names.back());
+        }
+        auto args = std::vector<char *>{argv[0]};
+        for (auto &f : flags) {
+            args.push_back(f.data());
+        }
+        std::shuffle(args.begin() + 1, args.end(), std::mt19937(42));
+
+        auto walk = walk_command();
+        auto parser = argparse::parser("bench", "Frozen tree benchmark.");
+        for (auto &name : names) {
+            walk.add(name);
+            parser.add_opt_flag('\0', name, "Flag.");
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (auto r = 0; r < rounds; ++r) {
+            if (walk.parse(args.data(), static_cast<int>(args.size())) == -1) {
+                std::cerr << "walk failed" << std::endl;
+                return 1;
+            }
+        }
+        auto walked = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        parser.finalize();
+        auto finalized = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        for (auto r = 0; r < rounds; ++r) {
+            if (!parser.parse(static_cast<int>(args.size()), args.data())) {
+                std::cerr << "parse failed" << std::endl;
+                return 1;
+            }
+        }
+        auto parsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << std::setw(10) << n << std::fixed << std::setprecision(1) << std::setw(15)
+                  << walked / rounds / n << std::setw(16) << parsed / rounds / n << std::setw(14) << finalized
+                  << std::endl;
+    }
+    return 0;
+}
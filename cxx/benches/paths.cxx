@@ -0,0 +1,57 @@
+/*
+ * Compares lists copying their values with lists referring to argv for commandlines with many paths.
+ *
+ * Each round parses `-p <N paths>` into an optional_list<std::string>, an optional_list<std::string_view> and an
+ * optional_span. The global operator new is replaced by alloc_count.hxx to count the heap allocations of each parse.
+ */
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "alloc_count.hxx"
+#include "argparse.hxx"
+
+template <typename Add, typename Size>
+static auto run(char const *label, std::vector<char *> &args, Add add, Size size) {
+    auto parser = argparse::parser("bench", "Paths benchmark.");
+    auto &list = add(parser);
+    parser.finalize();
+
+    allocations = 0;
+    auto start = std::chrono::steady_clock::now();
+    if (!parser.parse(static_cast<int>(args.size()), args.data()) || size(list) != args.size() - 2) {
+        std::cerr << "parse failed" << std::endl;
+        std::exit(1);
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    std::cout << std::setw(8) << args.size() - 2 << std::setw(14) << label << std::setw(10) << allocations
+              << std::setw(15) << std::fixed << std::setprecision(1) << elapsed / (args.size() - 2) << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    std::cout << "   paths          list    allocs    ns/path" << std::endl;
+    for (auto n : {1000, 50000, 1000000}) {
+        std::string name = "bench", flag = "-p", path = "/srv/data/some/longer/path/to/a/file";
+        std::vector<char *> args = {name.data(), flag.data()};
+        for (auto i = 0; i < n; ++i) {
+            args.push_back(path.data());
+        }
+
+        run(
+            "string", args,
+            [](auto &p) -> auto & { return p.template add_opt_list<std::string>('p', "paths", "Paths."); },
+            [](auto &l) { return l.get_values().size(); });
+        run(
+            "string_view", args,
+            [](auto &p) -> auto & { return p.template add_opt_list<std::string_view>('p', "paths", "Paths."); },
+            [](auto &l) { return l.get_values().size(); });
+        run(
+            "span", args, [](auto &p) -> auto & { return p.add_opt_span('p', "paths", "Paths."); },
+            [](auto &l) { return l.get_args().size(); });
+    }
+    return 0;
+}
@@ -0,0 +1,72 @@
+/*
+ * Builds, parses and drops one parser per request, as a request handler would.
+ *
+ * Each round constructs the parser with a subcommand, a handful of optionals and a list, parses a commandline of
+ * 64 arguments and reads the results. It runs once with the global heap and once with a monotonic buffer on the
+ * stack per request. The global operator new is replaced by alloc_count.hxx to count the heap allocations per
+ * request, which drop to zero with the buffer.
+ */
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "alloc_count.hxx"
+#include "argparse.hxx"
+
+static auto handle(std::pmr::memory_resource *resource, int argc, char **argv) -> size_t {
+    auto parser = argparse::parser("server", "Request benchmark.", resource);
+    auto &verbose = parser.add_opt_flag('v', "verbose", "Verbosity.");
+    auto &get = parser.add_command("get", "Fetch paths.");
+    auto &output = get.add_opt_value<std::pmr::string>('o', "output", "Output path.");
+    auto &retries = get.add_opt_value<int>('r', "retries", "Retries.");
+    auto &paths = get.add_opt_list<std::pmr::string>('p', "paths", "Paths to fetch.");
+    get.add_opt_flag('f', "force", "Overwrite.");
+
+    if (!parser.parse(argc, argv)) {
+        std::cerr << "parse failed" << std::endl;
+        std::exit(1);
+    }
+    return verbose.cnt() + output.get_value()->size() + *retries.get_value() + paths.get_values().size();
+}
+
+int main(int argc, char *argv[]) {
+    constexpr auto rounds = 100000;
+
+    std::string name = "server", verbose = "-v", get = "get", output = "--output", path = "out", retries = "-r",
+                count = "3", paths = "--paths", value = "/srv/data/some/longer/path/to/a/file";
+    std::vector<char *> args = {name.data(),   verbose.data(), get.data(),     output.data(),
+                                path.data(),   retries.data(), count.data(),   paths.data()};
+    while (args.size() < 64) {
+        args.push_back(value.data());
+    }
+
+    std::cout << "   resource   allocs/request   ns/request" << std::endl;
+    for (auto buffered : {false, true}) {
+        auto sum = size_t{0};
+        allocations = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (auto r = 0; r < rounds; ++r) {
+            if (buffered) {
+                alignas(std::max_align_t) std::array<std::byte, 64 * 1024> buffer;
+                auto resource =
+                    std::pmr::monotonic_buffer_resource(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+                sum += handle(&resource, static_cast<int>(args.size()), args.data());
+            } else {
+                sum += handle(std::pmr::get_default_resource(), static_cast<int>(args.size()), args.data());
+            }
+        }
+        auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        std::cout << std::setw(11) << (buffered ? "monotonic" : "heap") << std::fixed << std::setprecision(1)
+                  << std::setw(17) << static_cast<double>(allocations) / rounds << std::setw(13) << elapsed / rounds
+                  << std::endl;
+        if (sum == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,53 @@
+/*
+ * Verifies that parsing scales linearly with the number of commandline arguments.
+ *
+ * Each round parses `-o out -v -l <N list values> -v` for growing N. The time per argument stays constant since
+ * every argument is classified once by the pre-pass. The benchmark fails if the time per argument of the largest
+ * commandline exceeds max_ratio times that of the smallest, which a quadratic pass would exceed by far.
+ */
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "argparse.hxx"
+
+int main(int argc, char *argv[]) {
+    constexpr auto max_ratio = 3.0;
+    auto first = 0.0;
+    auto last = 0.0;
+
+    std::cout << "      args     parse ns/arg" << std::endl;
+    for (auto n : {1000, 10000, 100000, 1000000}) {
+        std::string name = "bench", output = "-o", path = "out", verbose = "-v", list = "-l", value = "list-value";
+        std::vector<char *> args = {name.data(), output.data(), path.data(), verbose.data(), list.data()};
+        for (auto i = 0; i < n; ++i) {
+            args.push_back(value.data());
+        }
+        args.push_back(verbose.data());
+
+        auto parser = argparse::parser("bench", "Scaling benchmark.");
+        parser.add_opt_value<std::string>('o', "output", "Output path.");
+        parser.add_opt_flag('v', "verbose", "Verbosity.");
+        parser.add_opt_list<std::string>('l', "list", "List of values.");
+
+        auto start = std::chrono::steady_clock::now();
+        if (!parser.parse(static_cast<int>(args.size()), args.data())) {
+            std::cerr << "parse failed" << std::endl;
+            return 1;
+        }
+        auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        std::cout << std::setw(10) << args.size() << std::setw(17) << std::fixed << std::setprecision(1)
+                  << elapsed / args.size() << std::endl;
+        first = first == 0.0 ? elapsed / args.size() : first;
+        last = elapsed / args.size();
+    }
+
+    if (last > max_ratio * first) {
+        std::cerr << "parse time per argument grew " << last / first << "x, more than " << max_ratio << "x"
+                  << std::endl;
+        return 1;
+    }
+    return 0;
+}
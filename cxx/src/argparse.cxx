@@ -22,9 +22,16 @@
  * SOFTWARE.
  *********************************************************************************************************************/
 
+#include <cerrno>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include "argparse.hxx"
 
 /*********************************************************************************************************************
@@ -35,25 +42,31 @@ template <> auto argparse::parse(char const *const s) -> int { return atoi(s); }
 
 template <> auto argparse::parse(char const *const s) -> std::string { return s; }
 
+template <> auto argparse::parse(char const *const s) -> std::string_view { return s; }
+
+template <>
+auto argparse::parse<std::pmr::string>(char const *const s, std::pmr::memory_resource *resource) -> std::pmr::string {
+    return std::pmr::string(s, resource);
+}
+
 /*********************************************************************************************************************
  * argparse::optional::optional implementation
  *********************************************************************************************************************/
 
-argparse::optional::optional(char _short, std::string_view _long, std::string_view _desc)
-    : _short(_short), _long(_long), _desc(_desc) {}
+argparse::optional::optional(info const &meta) : _info(&meta) {}
 
 argparse::optional::~optional() = default;
 
-auto argparse::optional::abbr() -> std::tuple<char, std::string_view> { return {_short, _long}; }
+auto argparse::optional::abbr() -> std::tuple<char, std::string_view> { return {_info->_short, _info->_long}; }
 
 auto argparse::optional::parse(char const *const * /*argv*/, int /*argc*/) -> int {
     throw std::runtime_error("Called 'parse' on optional type.");
 }
 
-auto argparse::optional::desc() -> std::string_view const & { return _desc; }
+auto argparse::optional::desc() -> std::string_view const & { return _info->_desc; }
 
-argparse::optional_flag::optional_flag(char _short, std::string_view _long, std::string_view _desc)
-    : optional(_short, _long, _desc), _cnt(0), _flag(false) {}
+argparse::optional_flag::optional_flag(info const &meta, std::pmr::memory_resource * /*resource*/)
+    : optional(meta), _cnt(0), _flag(false) {}
 
 auto argparse::optional_flag::takes() -> size_t { return 0; }
 
@@ -67,49 +80,124 @@ auto argparse::optional_flag::is_set() const -> bool { return _flag; }
 
 auto argparse::optional_flag::cnt() const -> size_t { return _cnt; }
 
+argparse::optional_span::optional_span(info const &meta, std::pmr::memory_resource * /*resource*/) : optional(meta) {}
+
+auto argparse::optional_span::takes() -> size_t { return std::numeric_limits<size_t>::max(); }
+
+auto argparse::optional_span::parse(char const *const *argv, int len) -> int {
+    if (len < 1 || !_args.empty()) {
+        return -1;
+    }
+    _args = std::span(argv, len);
+    return len;
+}
+
 /*********************************************************************************************************************
  * argparse::argument implementation
  *********************************************************************************************************************/
 
-argparse::argument::argument(std::string_view _name, std::string_view _desc) : _name(_name), _desc(_desc) {}
+argparse::argument::argument(info const &meta) : _info(&meta) {}
 argparse::argument::~argument() = default;
 
-auto argparse::argument::desc() -> std::string_view const & { return _desc; }
+auto argparse::argument::desc() -> std::string_view const & { return _info->_desc; }
 
-auto argparse::argument::name() -> std::string_view { return _name; }
+auto argparse::argument::name() -> std::string_view { return _info->_name; }
 
 auto argparse::argument::parse(char const *const * /*argv*/, int /*len*/) -> int {
     throw std::runtime_error("Called 'parse' on argument type.");
 }
 
+argparse::required_span::required_span(info const &meta, std::pmr::memory_resource * /*resource*/) : argument(meta) {}
+
+auto argparse::required_span::takes() -> size_t { return std::numeric_limits<size_t>::max(); }
+
+auto argparse::required_span::parse(char const *const *argv, int len) -> int {
+    if (len < 1 || !_args.empty()) {
+        return -1;
+    }
+    _args = std::span(argv, len);
+    return len;
+}
+
+/*********************************************************************************************************************
+ * argparse::name_index implementation
+ *********************************************************************************************************************/
+
+auto argparse::name_index::hash(std::string_view key) -> uint32_t {
+    // FNV-1a
+    auto h = uint32_t{2166136261u};
+    for (auto c : key) {
+        h = (h ^ static_cast<unsigned char>(c)) * 16777619u;
+    }
+    return h;
+}
+
+auto argparse::name_index::grow() -> void {
+    auto slots = std::pmr::vector<slot>(std::max<size_t>(16, _slots.size() * 2), _slots.get_allocator());
+    std::swap(slots, _slots);
+    for (auto s : slots) {
+        if (s.item != none) {
+            place(s);
+        }
+    }
+}
+
+auto argparse::name_index::place(slot s) -> void {
+    auto mask = _slots.size() - 1;
+    auto i = s.hash & mask;
+    while (_slots[i].item != none) {
+        i = (i + 1) & mask;
+    }
+    _slots[i] = s;
+}
+
 /*********************************************************************************************************************
  * argparse::command implementation
  *********************************************************************************************************************/
 
-argparse::command::command(std::string_view _name, std::string_view _desc) : argument(_name, _desc) {}
+argparse::command::command(std::string_view _name, std::string_view _desc, std::pmr::memory_resource *resource)
+    : argument(_meta), _meta{_name, _desc}, _resource(resource), _base(resource), _hot(resource), _cold(resource),
+      _optional(resource), _required(resource), _commands(resource), _long_index(resource), _required_index(resource),
+      _command_index(resource) {}
+
+argparse::command::~command() {
+    // The arenas only release the memory, the objects placed in them are destroyed here
+    for (auto *o : _optional) {
+        o->~optional();
+    }
+    for (auto *r : _required) {
+        r->~argument();
+    }
+    for (auto *c : _commands) {
+        std::pmr::polymorphic_allocator<>(_resource).delete_object(c);
+    }
+}
 
 auto argparse::command::add_command(std::string_view name, std::string_view desc) -> command & {
     if (name.find(' ') != std::string_view::npos) {
         std::cerr << "Command '" << name << "' contains space." << std::endl;
         abort();
     }
+    if (_frozen) {
+        throw std::runtime_error(std::string("Command added after finalize for ") + name.data());
+    }
 
-    auto arg = std::make_unique<command>(name, desc);
-    if (std::ranges::any_of(_commands.begin(), _commands.end(),
-                            [name](auto &ptr) -> bool { return name == ptr->name(); })) {
+    auto pos = static_cast<uint32_t>(_commands.size());
+    if (!_command_index.insert(name, pos, [this](uint32_t i) { return _commands[i]->name(); })) {
         auto msg = std::string("Duplicated command for ") + name.data();
         throw std::runtime_error(msg);
     }
 
-    auto s = std::string(_name.data()) + " ";
-    if (!_base.empty()) {
+    auto *cmd = std::pmr::polymorphic_allocator<>(_resource).new_object<command>(name, desc, _resource);
+    _commands.push_back(cmd);
 
-        s = std::string(_base.data()) + " " + s;
+    auto s = std::pmr::string(_resource);
+    if (!_base.empty()) {
+        s.append(_base).append(" ");
     }
+    s.append(_meta._name).append(" ");
 
-    arg->set_base(s);
-    auto cmd = arg.get();
-    _commands.push_back(std::move(arg));
+    cmd->set_base(s);
     return *cmd;
 }
 
@@ -117,40 +205,137 @@ auto argparse::command::takes() -> size_t { return std::numeric_limits<size_t>::
 
 void argparse::command::set_base(std::string_view base) { _base = base; }
 
-auto argparse::command::parse(char const *const *argv, int argc) -> int {
-    auto next_idx = [argc, argv](int pos) -> int {
-        for (auto i = pos; i < argc; ++i) {
-            std::string_view sv(argv[i]);
-            if (sv.starts_with("-")) {
-                return i;
-            }
+auto argparse::command::tokenize(char const *const *argv, int argc, std::pmr::memory_resource *resource) -> tokens {
+    auto result = tokens{std::pmr::vector<token>(argc, resource), std::pmr::vector<int>(argc + 1, 0, resource)};
+    for (auto i = argc - 1; i >= 0; --i) {
+        std::string_view sv(argv[i]);
+        if (sv == "--help" || sv == "-h") {
+            result.kinds[i] = token::help;
+        } else if (sv == "--") {
+            result.kinds[i] = token::separator;
+        } else if (sv.starts_with('-')) {
+            result.kinds[i] = token::flag;
+        } else {
+            result.kinds[i] = token::value;
         }
-        return argc;
-    };
+        result.runs[i] = sv.starts_with('-') ? 0 : result.runs[i + 1] + 1;
+    }
+    return result;
+}
+
+auto argparse::command::compile(command &root) -> table {
+    auto tbl = table{root._resource};
+    tbl.nodes.push_back(table::node{.name = root.name(), .cmd = &root});
+
+    // Appending the subcommands of each node while walking the nodes lays out the tree breadth first
+    for (auto idx = size_t{0}; idx < tbl.nodes.size(); ++idx) {
+        auto *cmd = tbl.nodes[idx].cmd;
+        cmd->_frozen = true;
+
+        auto options = table::range{static_cast<uint32_t>(tbl.options.size())};
+        for (auto &o : cmd->_optional) {
+            auto [s, l] = o->abbr();
+            tbl.options.push_back(table::option{l, o->takes(), o});
+        }
+        options.end = static_cast<uint32_t>(tbl.options.size());
+        for (auto i = options.begin; i < options.end; ++i) {
+            tbl.sorted.push_back(i);
+        }
+        std::ranges::sort(tbl.sorted.begin() + options.begin, tbl.sorted.end(), {},
+                          [&tbl](uint32_t i) { return tbl.options[i].name; });
+
+        auto required = table::range{static_cast<uint32_t>(tbl.required.size())};
+        for (auto &r : cmd->_required) {
+            tbl.required.push_back(r);
+        }
+        required.end = static_cast<uint32_t>(tbl.required.size());
+
+        auto commands = table::range{static_cast<uint32_t>(tbl.nodes.size())};
+        for (auto &c : cmd->_commands) {
+            tbl.nodes.push_back(table::node{.name = c->name(), .cmd = c});
+        }
+        commands.end = static_cast<uint32_t>(tbl.nodes.size());
+
+        auto &node = tbl.nodes[idx];
+        node.options = options;
+        node.required = required;
+        node.commands = commands;
+        for (auto c = size_t{0}; c < node.shorts.size(); ++c) {
+            auto pos = cmd->_short_index[c];
+            node.shorts[c] = pos != table::none ? options.begin + pos : table::none;
+        }
+    }
+    return tbl;
+}
+
+auto argparse::command::find_long(table const &tbl, table::node const &node, std::string_view arg, bool abbrev)
+    -> table::option const * {
+    auto options = std::span(tbl.options).subspan(node.options.begin, node.options.end - node.options.begin);
+    auto pos = node.cmd->_long_index.find(arg, [options](uint32_t i) { return options[i].name; });
+    if (pos != table::none) {
+        return &options[pos];
+    }
+    if (!abbrev) {
+        return nullptr;
+    }
+
+    auto sorted = std::span(tbl.sorted).subspan(node.options.begin, node.options.end - node.options.begin);
+    auto name = [&tbl](uint32_t i) { return tbl.options[i].name; };
+    auto it = std::ranges::lower_bound(sorted, arg, {}, name);
+    if (it == sorted.end() || !name(*it).starts_with(arg)) {
+        return nullptr;
+    }
+
+    // Names are unique, thus the prefix is ambiguous if the next name starts with it as well
+    auto next = std::next(it);
+    if (next == sorted.end() || !name(*next).starts_with(arg)) {
+        return &tbl.options[*it];
+    }
+    std::cerr << "Ambiguous option: --" << arg << " could be";
+    auto sep = " ";
+    for (; it != sorted.end() && name(*it).starts_with(arg); ++it) {
+        std::cerr << sep << "--" << name(*it);
+        sep = ", ";
+    }
+    std::cerr << std::endl;
+    return nullptr;
+}
+
+auto argparse::command::parse(table const &tbl, uint32_t idx, char const *const *argv, int argc,
+                              std::span<token const> kinds, std::span<int const> runs, bool abbrev) -> int {
+    auto const &node = tbl.nodes[idx];
+    auto commands = std::span(tbl.nodes).subspan(node.commands.begin, node.commands.end - node.commands.begin);
 
     auto pos = 1;
     while (pos < argc) {
         std::string_view sv(argv[pos]);
-        auto end = next_idx(pos + 1);
+        auto end = pos + 1 + runs[pos + 1];
 
-        if (sv == "--help" || sv == "-h") {
-            show_help();
+        if (kinds[pos] == token::help) {
+            node.cmd->show_help();
             return -1;
-        } else if (sv.starts_with('-') && sv != "--") {
-            auto handle = [&](std::string_view const arg) -> bool {
-                auto v =
-                    std::ranges::filter_view(std::span(_optional.begin(), _optional.end()), [arg](auto &ptr) -> bool {
-                        auto [s, l] = ptr->abbr();
-                        return arg.length() == 1 ? (s == arg[0]) : (l == arg);
-                    });
-
-                if (v.empty()) {
+        } else if (kinds[pos] == token::flag) {
+            // Long flags are looked up by name whatever their length, thus `--v` may abbreviate `--verbose`
+            auto handle = [&](std::string_view const arg, bool const is_long) -> bool {
+                table::option const *opt = nullptr;
+                if (!is_long) {
+                    auto c = static_cast<unsigned char>(arg[0]);
+                    auto i = node.shorts[c];
+                    opt = i != table::none ? &tbl.options[i] : nullptr;
+                } else {
+                    opt = find_long(tbl, node, arg, abbrev);
+                }
+
+                if (opt == nullptr) {
                     return false;
                 }
 
-                auto used = (*v.begin())->parse(&argv[pos + 1], end - pos - 1);
+                // Only flags take no value, they are counted without a virtual call
+                auto used = opt->takes == 0
+                                ? static_cast<optional_flag *>(opt->target)->optional_flag::parse(nullptr, 0)
+                                : opt->target->parse(&argv[pos + 1], end - pos - 1);
                 if (used == -1) {
-                    show_help();
+                    node.cmd->show_help();
                     return false;
                 }
                 pos += used + 1;
@@ -158,35 +343,31 @@ auto argparse::command::parse(char const *const *argv, int argc) -> int {
             };
 
             if (sv.starts_with("--")) {
-                if (!handle(sv.substr(2))) {
+                if (!handle(sv.substr(2), true)) {
                     return -1;
                 }
             } else {
                 for (auto i = 1; i < sv.length(); ++i) {
-                    if (!handle(sv.substr(i, 1))) {
+                    if (!handle(sv.substr(i, 1), false)) {
                         return -1;
                     }
                 }
             }
         } else if (pos != argc) {
-            auto c = _commands.begin();
-            while (c != _commands.end()) {
-                if ((*c)->name() == sv) {
-                    auto used = (*c)->parse(&argv[pos], argc - pos);
-                    if (used == -1) {
-                        return -1;
-                    }
-                    pos += used + 1;
-                    break;
+            auto c = node.cmd->_command_index.find(sv, [commands](uint32_t i) { return commands[i].name; });
+            if (c != table::none) {
+                auto sub = node.commands.begin + c;
+                auto used = parse(tbl, sub, &argv[pos], argc - pos, kinds.subspan(pos), runs.subspan(pos), abbrev);
+                if (used == -1) {
+                    return -1;
                 }
-                ++c;
-            }
-            if (c == _commands.end()) {
-                for (auto &r : _required) {
+                pos += used + 1;
+            } else {
+                for (auto i = node.required.begin; i < node.required.end; ++i) {
                     if (pos >= argc) {
                         return -1;
                     }
-                    auto used = r->parse(&argv[pos], argc - pos);
+                    auto used = tbl.required[i]->parse(&argv[pos], argc - pos);
                     if (used == -1) {
                         return -1;
                     }
@@ -197,11 +378,11 @@ auto argparse::command::parse(char const *const *argv, int argc) -> int {
         }
     }
 
-    return _required.empty() ? argc : -1;
+    return node.required.begin == node.required.end ? argc : -1;
 }
 
 auto argparse::command::show_help() const -> void {
-    std::cout << std::endl << "    Usage: " << _base << _name << " ";
+    std::cout << std::endl << "    Usage: " << _base << _meta._name << " ";
 
     if (!_optional.empty()) {
         std::cout << "[OPTIONS] ";
@@ -219,17 +400,17 @@ auto argparse::command::show_help() const -> void {
     }
     std::cout << std::endl << std::endl;
 
-    if (!_desc.empty()) {
+    if (!_meta._desc.empty()) {
         size_t start = 0;
         size_t end = 0;
-        while (start < _desc.size()) {
-            auto pos = _desc.find(' ', end + 1);
+        while (start < _meta._desc.size()) {
+            auto pos = _meta._desc.find(' ', end + 1);
             if (pos == std::string_view::npos) {
-                std::cout << "    " << _desc.substr(start) << std::endl;
+                std::cout << "    " << _meta._desc.substr(start) << std::endl;
                 break;
             } else {
                 if ((pos - start) > 80) {
-                    std::cout << "    " << _desc.substr(start, end - start) << std::endl;
+                    std::cout << "    " << _meta._desc.substr(start, end - start) << std::endl;
 
                     start = end + 1;
 
@@ -252,7 +433,8 @@ auto argparse::command::show_help() const -> void {
         std::cout << "    Options:" << std::endl << std::endl;
         for (auto &o : _optional) {
             auto [s, l] = o->abbr();
-            std::cout << "        -" << s << ", --" << std::left << std::setw(width) << l << o->desc() << std::endl;
+            std::cout << "        " << (s != '\0' ? std::string{'-', s, ','} : "   ") << " --" << std::left
+                      << std::setw(width) << l << o->desc() << std::endl;
         }
         std::cout << std::endl;
     }
@@ -286,9 +468,219 @@ auto argparse::command::show_help() const -> void {
  * argparse::parser implementation
  *********************************************************************************************************************/
 
-argparse::parser::parser(std::string_view _name, std::string_view _desc) : command(_name, _desc) {}
+argparse::parser::parser(std::string_view _name, std::string_view _desc, std::pmr::memory_resource *resource)
+    : command(_name, _desc, resource), _table(resource) {}
 argparse::parser::~parser() = default;
 
-auto argparse::parser::parse(int argc, char *argv[]) -> bool { return command::parse(argv, argc) == -1 ? false : true; }
+auto argparse::parser::parse(int argc, char *argv[]) -> bool { return parse_args(argv, argc); }
+
+auto argparse::parser::parse(response const &args) -> bool { return parse_args(args.argv(), args.argc()); }
+
+auto argparse::parser::parse(line const &args) -> bool { return parse_args(args.argv(), args.argc()); }
+
+auto argparse::parser::parse_args(char const *const *argv, int argc) -> bool {
+    finalize();
+    auto [kinds, runs] = tokenize(argv, argc, _resource);
+    return command::parse(_table, 0, argv, argc, kinds, runs, _abbrev) == -1 ? false : true;
+}
+
+auto argparse::parser::finalize() -> void {
+    if (!_frozen) {
+        _table = compile(*this);
+    }
+}
+
+auto argparse::parser::set_abbrev(bool abbrev) -> void { _abbrev = abbrev; }
+
+/*********************************************************************************************************************
+ * argparse::response implementation
+ *********************************************************************************************************************/
+
+argparse::response::response(int argc, char const *const *argv, int depth, std::pmr::memory_resource *resource)
+    : _argv(resource), _maps(resource) {
+    _argv.reserve(argc + 1);
+    for (auto i = 0; i < argc; ++i) {
+        if (i == 0 || depth <= 0) {
+            _argv.push_back(argv[i]);
+        } else {
+            add(argv[i], depth);
+        }
+    }
+    _argv.push_back(nullptr);
+}
+
+argparse::response::~response() = default;
+
+auto argparse::response::argc() const -> int { return static_cast<int>(_argv.size() - 1); }
+
+auto argparse::response::argv() const -> char const *const * { return _argv.data(); }
+
+void argparse::response::unmap::operator()(char *addr) const { munmap(addr, size); }
+
+auto argparse::response::add(char const *arg, int depth) -> void {
+    if (arg[0] != '@' || arg[1] == '\0') {
+        _argv.push_back(arg);
+    } else if (depth == 0) {
+        throw std::runtime_error(std::string("Response files nested too deeply at ") + arg);
+    } else {
+        add_file(arg + 1, depth - 1);
+    }
+}
+
+auto argparse::response::add_file(char const *path, int depth) -> void {
+    auto fail = [path](int err) {
+        throw std::runtime_error(std::string("Failed to read response file ") + path + ": " + std::strerror(err));
+    };
+
+    struct descriptor {
+        int fd;
+        ~descriptor() { close(fd); }
+    } file{open(path, O_RDONLY | O_CLOEXEC)};
+    if (file.fd < 0) {
+        fail(errno);
+    }
+    struct stat st {};
+    if (fstat(file.fd, &st) != 0) {
+        fail(errno);
+    }
+
+    // FIFOs and procfs files report no size, their content is read and copied into the mapping instead
+    auto content = std::pmr::vector<char>(_maps.get_allocator().resource());
+    auto size = static_cast<size_t>(st.st_size);
+    if (size == 0) {
+        char chunk[4096];
+        for (auto n = read(file.fd, chunk, sizeof(chunk)); n != 0; n = read(file.fd, chunk, sizeof(chunk))) {
+            if (n < 0 && errno != EINTR) {
+                fail(errno);
+            } else if (n > 0) {
+                content.insert(content.end(), chunk, chunk + n);
+            }
+        }
+        size = content.size();
+    }
+
+    // The file is mapped privately over an anonymous mapping one byte larger, which terminates the last argument. The
+    // slot of the mapping is reserved first, thus the mapping is owned before anything else can throw.
+    _maps.reserve(_maps.size() + 1);
+    auto *addr =
+        static_cast<char *>(mmap(nullptr, size + 1, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if (addr == MAP_FAILED) {
+        fail(errno);
+    }
+    _maps.emplace_back(addr, unmap{size + 1});
+    if (!content.empty()) {
+        std::ranges::copy(content, addr);
+    } else if (size > 0 &&
+               mmap(addr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, file.fd, 0) == MAP_FAILED) {
+        fail(errno);
+    }
+
+    auto data = std::span<char>(addr, size);
+    if (std::ranges::find(data, '\0') != data.end()) {
+        // Arguments are already terminated, the mapping is only read
+        for (auto pos = size_t{0}; pos < size; pos += std::strlen(&data[pos]) + 1) {
+            add(&data[pos], depth);
+        }
+        return;
+    }
+
+    for (auto pos = size_t{0}; pos < size;) {
+        auto line = std::string_view(&data[pos], size - pos);
+        auto len = std::min(line.find('\n'), line.size());
+        auto next = pos + len + 1;
+        if (len > 0 && line[len - 1] == '\r') {
+            --len;
+        }
+        if (len > 0) {
+            // Terminate in place and remove enclosing quotes
+            auto *out = &data[pos];
+            auto quote = line[0];
+            if (len >= 2 && (quote == '"' || quote == '\'') && line[len - 1] == quote) {
+                for (auto i = size_t{1}; i + 1 < len; ++i) {
+                    if (quote == '"' && line[i] == '\\' && i + 2 < len && (line[i + 1] == '"' || line[i + 1] == '\\')) {
+                        ++i;
+                    }
+                    *out++ = line[i];
+                }
+            } else {
+                out += len;
+            }
+            *out = '\0';
+            add(&data[pos], depth);
+        }
+        pos = next;
+    }
+}
+
+/*********************************************************************************************************************
+ * argparse::line implementation
+ *********************************************************************************************************************/
+
+argparse::line::line(char const *name, std::pmr::memory_resource *resource) : _argv({name, nullptr}, resource) {}
+
+auto argparse::line::argc() const -> int { return static_cast<int>(_argv.size() - 1); }
+
+auto argparse::line::argv() const -> char const *const * { return _argv.data(); }
+
+auto argparse::line::tokenize(char *text) -> int {
+    auto blank = [](char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; };
+    auto skip = [&blank](char *in) {
+        while (blank(*in) || (in[0] == '\\' && in[1] == '\n')) {
+            in += in[0] == '\\' ? 2 : 1;
+        }
+        return in;
+    };
+    auto fail = [](char const *reason) { throw std::runtime_error(std::string("Failed to tokenize line: ") + reason); };
+
+    // The unescaped word never outgrows the input, thus out trails in and the words are written in place
+    _argv.resize(1);
+    auto *in = skip(text);
+    auto *out = in;
+    while (*in != '\0' && *in != '#') {
+        _argv.push_back(out);
+        while (*in != '\0' && !blank(*in)) {
+            auto c = *in++;
+            if (c == '\'') {
+                // Single quotes preserve every character up to the closing quote
+                auto *end = std::strchr(in, '\'');
+                if (end == nullptr) {
+                    fail("unterminated single quote");
+                }
+                // The ranges overlap once out trails in, which std::copy does not allow
+                std::memmove(out, in, static_cast<size_t>(end - in));
+                out += end - in;
+                in = end + 1;
+            } else if (c == '"') {
+                for (c = *in++; c != '"'; c = *in++) {
+                    if (c == '\0') {
+                        fail("unterminated double quote");
+                    } else if (c == '\\' && std::strchr("\"\\$`\n", *in) != nullptr && *in != '\0') {
+                        c = *in++;
+                        if (c == '\n') {
+                            continue;
+                        }
+                    }
+                    *out++ = c;
+                }
+            } else if (c != '\\') {
+                *out++ = c;
+            } else if (*in == '\0') {
+                fail("trailing backslash");
+            } else if (*in++ != '\n') {
+                *out++ = in[-1];
+            }
+        }
+
+        // Terminate the word, the blank ending it may be overwritten
+        auto last = *in == '\0';
+        *out++ = '\0';
+        if (last) {
+            break;
+        }
+        in = skip(in + 1);
+    }
+    _argv.push_back(nullptr);
+    return argc();
+}
 
 /*********************************************************************************************************************/
@@ -26,11 +26,15 @@
 #define __ARGPARSE_CXX__
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
 #include <limits>
 #include <memory>
+#include <memory_resource>
 #include <ranges>
 #include <span>
 #include <stdexcept>
+#include <string>
 #include <string_view>
 #include <variant>
 #include <vector>
@@ -42,31 +46,48 @@ namespace argparse {
  * argparse::parse template/specialization
  *
  * This template and its specializations are used to parse the input
- * arguments into the requested type. Currently only int and std::string
- * are already implemented.
+ * arguments into the requested type. Currently only int, std::string
+ * and std::string_view are already implemented. The overload taking a
+ * memory resource is used by all arguments, it allocates std::pmr::string
+ * values from it. A std::string_view refers to the argument itself and is
+ * only valid as long as the parsed argv, see argparse::optional_span.
  *
  * FIXME: Make it possible to pass a custom converter into any of the
  *        added arguments.
  *
  *********************************************************************************************************************/
 
-template <typename T> static auto parse(char const *const s) -> T;
+template <typename T> auto parse(char const *const s) -> T;
 
 template <> auto parse(char const *const s) -> int;
 template <> auto parse(char const *const s) -> std::string;
+template <> auto parse(char const *const s) -> std::string_view;
+
+template <typename T> auto parse(char const *const s, std::pmr::memory_resource * /*resource*/) -> T {
+    return parse<T>(s);
+}
+
+template <> auto parse<std::pmr::string>(char const *const s, std::pmr::memory_resource *resource) -> std::pmr::string;
 
 /*********************************************************************************************************************
  *
  * argparse::optional - base class for optional arguments
  *
- * This class specified the necessary interface methods and already
- * stores the common values, such as name and description.
+ * This class specified the necessary interface methods and refers to
+ * the common values, such as name and description. These are only read
+ * by the help, thus they are stored apart from the parse state.
  *
  *********************************************************************************************************************/
 
 class optional {
   public:
-    optional(char _short, std::string_view _long, std::string_view _desc);
+    struct info {
+        char _short;
+        std::string_view _long;
+        std::string_view _desc;
+    };
+
+    explicit optional(info const &meta);
     virtual ~optional();
 
     optional(optional &&) = delete;
@@ -82,9 +103,7 @@ class optional {
     virtual auto parse(char const *const *argv, int argc) -> int;
 
   protected:
-    char _short;
-    std::string_view _long;
-    std::string_view _desc;
+    info const *_info;
 };
 
 /*********************************************************************************************************************
@@ -99,7 +118,7 @@ class optional {
 
 class optional_flag : public optional {
   public:
-    optional_flag(char _short, std::string_view _long, std::string_view _desc);
+    optional_flag(info const &meta, std::pmr::memory_resource *resource);
 
     auto cnt() const -> size_t;
     auto is_set() const -> bool;
@@ -123,7 +142,7 @@ class optional_flag : public optional {
 
 template <typename T> class optional_value : public optional {
   public:
-    optional_value(char _short, std::string_view _long, std::string_view _desc) : optional(_short, _long, _desc) {}
+    optional_value(info const &meta, std::pmr::memory_resource *resource) : optional(meta), _resource(resource) {}
 
     auto get_value() const -> T const * { return std::get_if<T>(&_value); }
 
@@ -132,11 +151,12 @@ template <typename T> class optional_value : public optional {
         if (len < 1) {
             return -1;
         }
-        _value = argparse::parse<T>(argv[0]);
+        _value = argparse::parse<T>(argv[0], _resource);
         return 1;
     }
 
   private:
+    std::pmr::memory_resource *_resource;
     std::variant<std::monostate, T> _value;
 };
 
@@ -151,10 +171,9 @@ template <typename T> class optional_value : public optional {
 
 template <typename T> class optional_list : public optional {
   public:
-    optional_list(char _short, std::string_view _long, std::string_view _desc)
-        : optional(_short, _long, _desc), _values() {}
+    optional_list(info const &meta, std::pmr::memory_resource *resource) : optional(meta), _values(resource) {}
 
-    auto get_values() const -> std::vector<T> const & { return _values; }
+    auto get_values() const -> std::pmr::vector<T> const & { return _values; }
 
     auto takes() -> size_t override { return std::numeric_limits<size_t>::max(); }
     auto parse(char const *const *argv, int len) -> int override {
@@ -163,7 +182,7 @@ template <typename T> class optional_list : public optional {
         }
         auto cnt = 0;
         for (const auto &v : std::span(argv, len)) {
-            _values.push_back(argparse::parse<T>(v));
+            _values.push_back(argparse::parse<T>(v, _values.get_allocator().resource()));
             cnt += 1;
         }
 
@@ -171,21 +190,60 @@ template <typename T> class optional_list : public optional {
     }
 
   private:
-    std::vector<T> _values;
+    std::pmr::vector<T> _values;
+};
+
+/*********************************************************************************************************************
+ *
+ * argparse::optional_span - specialization of optional for unparsed lists
+ *
+ * An instance of this class will refer to an optional list of values on
+ * the commandline without copying them. The values are handed out as
+ * std::string_view pointing into the parsed argv, thus they are only
+ * valid as long as argv: for the lifetime of the process if parsing the
+ * argv of main, as long as the argparse::response or until the next
+ * tokenize of the argparse::line otherwise. Inputs that do not outlive
+ * the results have to be parsed into std::string or std::pmr::string
+ * lists instead. Unlike the other lists, the values have to be given at
+ * once, a second occurrence fails the parse.
+ *
+ *********************************************************************************************************************/
+
+class optional_span : public optional {
+  public:
+    optional_span(info const &meta, std::pmr::memory_resource *resource);
+
+    auto get_args() const -> std::span<char const *const> { return _args; }
+    auto get_values() const {
+        return _args | std::views::transform([](char const *s) { return std::string_view(s); });
+    }
+
+    auto takes() -> size_t override;
+    auto parse(char const *const *argv, int len) -> int override;
+
+  private:
+    std::span<char const *const> _args;
 };
 
 /*********************************************************************************************************************
  *
  * argparse::argument - base class of required/non-optional parameters
  *
- * This class specified the necessary interface methods and already
- * stores the common values, such as name and description.
+ * This class specified the necessary interface methods and refers to
+ * the common values, such as name and description. These are only read
+ * by the help and the lookup by name, thus they are stored apart from
+ * the parse state.
  *
  *********************************************************************************************************************/
 
 class argument {
   public:
-    argument(std::string_view _name, std::string_view _desc);
+    struct info {
+        std::string_view _name;
+        std::string_view _desc;
+    };
+
+    explicit argument(info const &meta);
     virtual ~argument();
 
     argument(argument &&) = delete;
@@ -201,8 +259,7 @@ class argument {
     virtual auto parse(char const *const *argv, int len) -> int;
 
   protected:
-    std::string_view _name;
-    std::string_view _desc;
+    info const *_info;
 };
 
 /*********************************************************************************************************************
@@ -216,7 +273,7 @@ class argument {
 
 template <typename T> class required_value : public argument {
   public:
-    required_value(std::string_view _name, std::string_view _desc) : argument(_name, _desc) {}
+    required_value(info const &meta, std::pmr::memory_resource *resource) : argument(meta), _resource(resource) {}
 
     auto get_value() const -> T const * { return std::get_if<T>(&_value); }
 
@@ -225,12 +282,12 @@ template <typename T> class required_value : public argument {
         if (len < 1) {
             return -1;
         }
-        _value = argparse::parse<T>(argv[0]);
+        _value = argparse::parse<T>(argv[0], _resource);
         return 1;
     }
 
   private:
-    std::string_view _name;
+    std::pmr::memory_resource *_resource;
     std::variant<std::monostate, T> _value;
 };
 
@@ -245,9 +302,9 @@ template <typename T> class required_value : public argument {
 
 template <typename T> class required_list : public argument {
   public:
-    required_list(std::string_view _name, std::string_view _desc) : argument(_name, _desc), _values() {}
+    required_list(info const &meta, std::pmr::memory_resource *resource) : argument(meta), _values(resource) {}
 
-    auto get_values() const -> std::vector<T> const & { return _values; }
+    auto get_values() const -> std::pmr::vector<T> const & { return _values; }
 
     auto takes() -> size_t override { return std::numeric_limits<size_t>::max(); }
     auto parse(char const *const *argv, int len) -> int override {
@@ -258,14 +315,100 @@ template <typename T> class required_list : public argument {
         auto cnt = 0;
         for (const auto &v : std::span(argv, len)) {
 
-            _values.push_back(argparse::parse<T>(v));
+            _values.push_back(argparse::parse<T>(v, _values.get_allocator().resource()));
             cnt += 1;
         }
         return cnt;
     }
 
   private:
-    std::vector<T> _values;
+    std::pmr::vector<T> _values;
+};
+
+/*********************************************************************************************************************
+ *
+ * argparse::required_span - specialization of argument for unparsed lists
+ *
+ * An instance of this class will refer to a required list of values on
+ * the commandline without copying them. The same lifetime applies as for
+ * argparse::optional_span.
+ *
+ *********************************************************************************************************************/
+
+class required_span : public argument {
+  public:
+    required_span(info const &meta, std::pmr::memory_resource *resource);
+
+    auto get_args() const -> std::span<char const *const> { return _args; }
+    auto get_values() const {
+        return _args | std::views::transform([](char const *s) { return std::string_view(s); });
+    }
+
+    auto takes() -> size_t override;
+    auto parse(char const *const *argv, int len) -> int override;
+
+  private:
+    std::span<char const *const> _args;
+};
+
+/*********************************************************************************************************************
+ *
+ * argparse::name_index - Open-addressing hash index over named items
+ *
+ * Maps names to the position of the item in its owning container. The
+ * names are not stored, the given callable returns the name of an item
+ * by its position for comparison. Slots are probed linearly and the
+ * index is kept at most half full, thus lookups take O(1) on average.
+ *
+ *********************************************************************************************************************/
+
+class name_index {
+  public:
+    static constexpr uint32_t none = std::numeric_limits<uint32_t>::max();
+
+    explicit name_index(std::pmr::memory_resource *resource) : _slots(resource) {}
+
+    // Returns the position of the item named key, none if absent
+    template <typename Name> auto find(std::string_view key, Name const &name) const -> uint32_t {
+        if (_slots.empty()) {
+            return none;
+        }
+        auto h = hash(key);
+        auto mask = _slots.size() - 1;
+        for (auto i = h & mask; _slots[i].item != none; i = (i + 1) & mask) {
+            if (_slots[i].hash == h && name(_slots[i].item) == key) {
+                return _slots[i].item;
+            }
+        }
+        return none;
+    }
+
+    // Adds the item at position item named key, returns false if an item of the same name exists
+    template <typename Name> auto insert(std::string_view key, uint32_t item, Name const &name) -> bool {
+        if (find(key, name) != none) {
+            return false;
+        }
+        if ((_size + 1) * 2 > _slots.size()) {
+            grow();
+        }
+        place(slot{hash(key), item});
+        _size += 1;
+        return true;
+    }
+
+  private:
+    struct slot {
+        uint32_t hash;
+        uint32_t item = none;
+    };
+
+    std::pmr::vector<slot> _slots;
+    size_t _size = 0;
+
+    static auto hash(std::string_view key) -> uint32_t;
+
+    auto grow() -> void;
+    auto place(slot s) -> void;
 };
 
 /*********************************************************************************************************************
@@ -283,8 +426,11 @@ class command : public argument {
     friend class argparse;
 
   public:
-    command(std::string_view _name, std::string_view _desc);
+    command(std::string_view _name, std::string_view _desc,
+            std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+    ~command() override;
 
+    // Optionals given '\0' as flag are only available through their long flag
     auto add_opt_flag(char const flag, std::string_view const long_flag,
                       std::string_view description) -> optional_flag const & {
         return add_optional_arg<optional_flag>(flag, long_flag, description);
@@ -303,15 +449,24 @@ class command : public argument {
     }
 
     template <typename T>
-    auto add_req_value(std::string_view const name, std::string_view const description) -> optional_value<T> const & {
+    auto add_req_value(std::string_view const name, std::string_view const description) -> required_value<T> const & {
         return add_required_arg<required_value<T>>(name, description);
     }
 
     template <typename T>
-    auto add_req_list(std::string_view const name, std::string_view const description) -> optional_list<T> const & {
+    auto add_req_list(std::string_view const name, std::string_view const description) -> required_list<T> const & {
         return add_required_arg<required_list<T>>(name, description);
     }
 
+    auto add_opt_span(char const flag, std::string_view const long_flag,
+                      std::string_view description) -> optional_span const & {
+        return add_optional_arg<optional_span>(flag, long_flag, description);
+    }
+
+    auto add_req_span(std::string_view const name, std::string_view const description) -> required_span const & {
+        return add_required_arg<required_span>(name, description);
+    }
+
     template <typename T>
     auto add_req_list(char const flag, std::string_view const long_flag,
                       std::string_view description) -> optional_list<T> const & {
@@ -338,68 +493,241 @@ class command : public argument {
         return get_required<required_list<t>>(name);
     }
 
+    auto get_opt_span(std::string_view const long_flag) -> optional_span const & {
+        return get_optional<optional_span>(long_flag);
+    }
+
+    auto get_req_span(std::string_view const name) -> required_span const & {
+        return get_required<required_span>(name);
+    }
+
     auto takes() -> size_t override;
 
     auto add_command(std::string_view name, std::string_view desc) -> command &;
 
   protected:
-    std::string _base;
-    std::vector<std::unique_ptr<optional>> _optional;
-    std::vector<std::unique_ptr<argument>> _required;
-    std::vector<std::unique_ptr<command>> _commands;
+    // Few commands exist, thus they keep their name and description inline
+    info _meta;
+
+    // Source of all memory of this command, its arguments and its subcommands
+    std::pmr::memory_resource *_resource;
+
+    std::pmr::string _base;
+
+    // Optionals and required arguments are placed next to each other in the hot arena, their help metadata in the
+    // cold arena. Nothing is moved once placed, thus the returned references stay valid.
+    std::pmr::monotonic_buffer_resource _hot;
+    std::pmr::monotonic_buffer_resource _cold;
+
+    std::pmr::vector<optional *> _optional;
+    std::pmr::vector<argument *> _required;
+    std::pmr::vector<command *> _commands;
+
+    // Maps every short flag to its position in _optional
+    std::array<uint32_t, 256> _short_index = make_short_index();
+
+    // Positions of optionals by long flag, of required arguments and subcommands by name
+    name_index _long_index;
+    name_index _required_index;
+    name_index _command_index;
+
+    // Set once the tree containing this command was finalized, further arguments are rejected
+    bool _frozen = false;
+
+    static constexpr auto make_short_index() -> std::array<uint32_t, 256> {
+        auto idx = std::array<uint32_t, 256>{};
+        idx.fill(name_index::none);
+        return idx;
+    }
 
     auto show_help() const -> void;
 
     void set_base(std::string_view base);
 
-    auto parse(char const *const *argv, int argc) -> int override;
+    // Classification of a single commandline argument
+    enum class token : unsigned char { value, flag, separator, help };
+
+    // Result of the single pre-pass over all arguments. For each position, runs holds the count of consecutive
+    // values starting at that position, thus the next option is found without rescanning the arguments.
+    struct tokens {
+        std::pmr::vector<token> kinds;
+        std::pmr::vector<int> runs;
+    };
+
+    static auto tokenize(char const *const *argv, int argc, std::pmr::memory_resource *resource) -> tokens;
+
+    // Contiguous tables of a whole command tree. Commands are stored breadth first, thus the subcommands of each
+    // command form a range of nodes. The optionals, required arguments and subcommands of a command keep the order
+    // of registration, thus the positions in the name indices of the command are offsets into their ranges. The
+    // sorted range holds the optionals of each command ordered by long name to resolve unique prefixes.
+    struct table {
+        static constexpr uint32_t none = name_index::none;
+
+        struct range {
+            uint32_t begin = 0;
+            uint32_t end = 0;
+        };
+
+        struct option {
+            std::string_view name;
+            size_t takes;
+            optional *target;
+        };
+
+        struct node {
+            std::string_view name;
+            command *cmd = nullptr;
+            range options{};
+            range required{};
+            range commands{};
+            // Maps every short flag to its index into options
+            std::array<uint32_t, 256> shorts{};
+        };
+
+        explicit table(std::pmr::memory_resource *resource)
+            : nodes(resource), options(resource), sorted(resource), required(resource) {}
+
+        std::pmr::vector<node> nodes;
+        std::pmr::vector<option> options;
+        std::pmr::vector<uint32_t> sorted;
+        std::pmr::vector<argument *> required;
+    };
+
+    static auto compile(command &root) -> table;
+
+    static auto parse(table const &tbl, uint32_t idx, char const *const *argv, int argc, std::span<token const> kinds,
+                      std::span<int const> runs, bool abbrev) -> int;
+
+    static auto find_long(table const &tbl, table::node const &node, std::string_view arg, bool abbrev)
+        -> table::option const *;
 
   private:
     template <typename Opt>
     auto add_optional_arg(char const _short, std::string_view _long, std::string_view _desc) -> Opt const & {
-        auto opt = std::make_unique<Opt>(_short, _long, _desc);
-        if (std::ranges::any_of(_optional.begin(), _optional.end(), [_short, _long](auto &ptr) -> bool {
-                auto [s, l] = ptr->abbr();
-                return s == _short || l == _long;
-            })) {
+        if (_frozen) {
+            throw std::runtime_error(std::string("Optional argument added after finalize for ") + _long.data());
+        }
+        auto pos = static_cast<uint32_t>(_optional.size());
+        auto &short_pos = _short_index[static_cast<unsigned char>(_short)];
+        if ((_short != '\0' && short_pos != name_index::none) ||
+            (!_long.empty() && !_long_index.insert(_long, pos, [this](uint32_t i) { return long_name(i); }))) {
             auto msg = std::string("Duplicated optional argument for ") + _short + "/" + _long.data();
             throw std::runtime_error(msg);
         }
-        _optional.push_back(std::move(opt));
-        return *reinterpret_cast<Opt *>(_optional.back().get());
+        if (_short != '\0') {
+            short_pos = pos;
+        }
+        auto *meta = std::pmr::polymorphic_allocator<>(&_cold).new_object<optional::info>(_short, _long, _desc);
+        auto *opt = std::pmr::polymorphic_allocator<>(&_hot).new_object<Opt>(*meta, _resource);
+        _optional.push_back(opt);
+        return *opt;
     }
 
-    template <typename Arg> auto add_required_arg(std::string_view _name, std::string_view _desc) {
-        auto arg = std::make_unique<Arg>(_name, _desc);
-        if (std::ranges::any_of(_required.begin(), _required.end(),
-                                [_name](auto &ptr) -> bool { return _name == ptr->name(); })) {
+    template <typename Arg> auto add_required_arg(std::string_view _name, std::string_view _desc) -> Arg const & {
+        if (_frozen) {
+            throw std::runtime_error(std::string("Required argument added after finalize for ") + _name.data());
+        }
+        auto pos = static_cast<uint32_t>(_required.size());
+        if (!_required_index.insert(_name, pos, [this](uint32_t i) { return _required[i]->name(); })) {
             auto msg = std::string("Duplicated required argument for ") + _name.data();
             throw std::runtime_error(msg);
         }
-        _required.push_back(std::move(arg));
+        auto *meta = std::pmr::polymorphic_allocator<>(&_cold).new_object<argument::info>(_name, _desc);
+        auto *arg = std::pmr::polymorphic_allocator<>(&_hot).new_object<Arg>(*meta, _resource);
+        _required.push_back(arg);
+        return *arg;
     }
 
+    auto long_name(uint32_t pos) const -> std::string_view { return std::get<1>(_optional[pos]->abbr()); }
+
     template <typename T> auto get_optional(std::string_view _long) -> T const & {
-        auto v = std::ranges::filter_view(std::span(_optional.begin(), _optional.end()), [_long](auto &ptr) -> bool {
-            auto [s, l] = ptr->abbr();
-            return l == _long;
-        });
-        if (v.empty()) {
+        auto pos = _long_index.find(_long, [this](uint32_t i) { return long_name(i); });
+        if (pos == name_index::none) {
             abort();
         }
-        return *dynamic_cast<T const *>(v.begin()->get());
+        return *dynamic_cast<T const *>(_optional[pos]);
     }
 
     template <typename T> auto get_required(std::string_view _name) -> T const & {
-        auto v = std::ranges::filter_view(std::span(_required.begin(), _required.end()),
-                                          [_name](auto &ptr) -> bool { return ptr->name() == _name; });
-        if (v.empty()) {
+        auto pos = _required_index.find(_name, [this](uint32_t i) { return _required[i]->name(); });
+        if (pos == name_index::none) {
             abort();
         }
-        return *dynamic_cast<T const *>(v.begin()->get());
+        return *dynamic_cast<T const *>(_required[pos]);
     }
 };
 
+/*********************************************************************************************************************
+ *
+ * argparse::response - Commandline with expanded response files
+ *
+ * Every argument after argv[0] starting with '@' names a response file,
+ * which is memory mapped and tokenized in place. Files containing a NUL
+ * byte hold NUL separated arguments, any other file holds one argument
+ * per line with empty lines skipped. A line enclosed in single or double
+ * quotes is taken without the quotes, within double quotes \" and \\ are
+ * unescaped. Response files may name further response files up to the
+ * given depth. The arguments point into the mappings, thus the response
+ * has to outlive the parser results.
+ *
+ *********************************************************************************************************************/
+
+class response {
+  public:
+    response(int argc, char const *const *argv, int depth = 8,
+             std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+    ~response();
+
+    response(response &&) = delete;
+    response(response const &) = delete;
+
+    auto operator=(response &&) -> response & = delete;
+    auto operator=(response const &) -> response & = delete;
+
+    auto argc() const -> int;
+    auto argv() const -> char const *const *;
+
+  private:
+    struct unmap {
+        size_t size;
+        void operator()(char *addr) const;
+    };
+
+    std::pmr::vector<char const *> _argv;
+    std::pmr::vector<std::unique_ptr<char, unmap>> _maps;
+
+    auto add(char const *arg, int depth) -> void;
+    auto add_file(char const *path, int depth) -> void;
+};
+
+/*********************************************************************************************************************
+ *
+ * argparse::line - Commandline split from a line of an interactive console
+ *
+ * Splits a line into words following the quoting rules of the POSIX
+ * shell: words are separated by blanks, a word starting with # comments
+ * out the rest of the line, single quotes keep every character, within
+ * double quotes a backslash only escapes $, `, ", \ and newline, outside
+ * of quotes it escapes any character. No expansions are performed. The
+ * words are unescaped in place, thus the text has to outlive the parser
+ * results. argv[0] is the name given on construction and the array is
+ * reused, thus tokenizing allocates nothing once it fits the longest line.
+ *
+ *********************************************************************************************************************/
+
+class line {
+  public:
+    explicit line(char const *name, std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+    auto tokenize(char *text) -> int;
+
+    auto argc() const -> int;
+    auto argv() const -> char const *const *;
+
+  private:
+    std::pmr::vector<char const *> _argv;
+};
+
 /*********************************************************************************************************************
  *
  * argparse::parser - CLI parser class
@@ -408,13 +736,17 @@ class command : public argument {
  * like the argparse::command with the only difference that it will return
  * a simple true/false as parsing result instead of custom integer values
  * that are for internal use to propagate how many arguments were taken
- * by the given argument.
+ * by the given argument. All memory of the tree, its tables and parsed
+ * values is taken from the given memory resource, e.g. a monotonic
+ * buffer per request. Values of type std::pmr::string are allocated
+ * from it as well, std::string values use the global heap.
  *
  *********************************************************************************************************************/
 
 class parser : public command {
   public:
-    parser(std::string_view _name, std::string_view _desc);
+    parser(std::string_view _name, std::string_view _desc,
+           std::pmr::memory_resource *resource = std::pmr::get_default_resource());
     ~parser();
 
     // Prevent unnecessary copy or move
@@ -425,6 +757,22 @@ class parser : public command {
     auto operator=(parser const &) -> parser & = delete;
 
     auto parse(int argc, char *argv[]) -> bool;
+    auto parse(response const &args) -> bool;
+    auto parse(line const &args) -> bool;
+
+    // Compiles the whole command tree into contiguous tables used by all following parses. Called implicitly by the
+    // first parse, afterwards adding arguments or commands to any command of the tree throws.
+    auto finalize() -> void;
+
+    // Enables unique-prefix abbreviations of long flags, e.g. `--verb` for `--verbose`. An exact name always takes
+    // precedence, a prefix of several long flags fails the parse and reports all candidates. Disabled by default.
+    auto set_abbrev(bool abbrev) -> void;
+
+  private:
+    bool _abbrev = false;
+    table _table;
+
+    auto parse_args(char const *const *argv, int argc) -> bool;
 };
 
 } // namespace argparse
@@ -0,0 +1,40 @@
+/*
+ * Tokenizes lines whose quotes and escapes shift the rest of the line left while it is unescaped in place.
+ *
+ * Each case lists the expected words, the test fails with the first line tokenized differently.
+ */
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "argparse.hxx"
+
+static auto check(std::string_view text, std::vector<std::string_view> const &words) -> bool {
+    auto buffer = std::string(text);
+    auto args = argparse::line("console");
+    auto argc = args.tokenize(buffer.data());
+
+    auto ok = argc == static_cast<int>(words.size() + 1) && args.argv()[argc] == nullptr;
+    for (auto i = 0; ok && i < static_cast<int>(words.size()); ++i) {
+        ok = words[i] == args.argv()[i + 1];
+    }
+    if (!ok) {
+        std::cerr << "line not tokenized as expected: " << text << std::endl;
+    }
+    return ok;
+}
+
+int main() {
+    auto ok = true;
+    // Single quotes after an escape, the quoted text moves left over its own input
+    ok &= check(R"(a\ b'cdefghijklmnop' q)", {"a bcdefghijklmnop", "q"});
+    // Several quotes in one word, every one shifts the following text further left
+    ok &= check(R"('ab''cdefgh''ijklmnopqrstuvwxyz' tail)", {"abcdefghijklmnopqrstuvwxyz", "tail"});
+    // Double quotes with escapes ahead of a long single quoted run
+    ok &= check(R"("x\"y"'0123456789abcdefghij' "\\" end)", {"x\"y0123456789abcdefghij", "\\", "end"});
+    // Line continuation within a word and a comment after the last word
+    ok &= check("ab\\\ncd 'e f' # comment", {"abcd", "e f"});
+    return ok ? 0 : 1;
+}